@@ -0,0 +1,13 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/dicek_bench.dir/storage_policyBench.cpp.o"
+  "CMakeFiles/dicek_bench.dir/storage_policyBench.cpp.o.d"
+  "CMakeFiles/dicek_bench.dir/vectorBench.cpp.o"
+  "CMakeFiles/dicek_bench.dir/vectorBench.cpp.o.d"
+  "dicek_bench"
+  "dicek_bench.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/dicek_bench.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
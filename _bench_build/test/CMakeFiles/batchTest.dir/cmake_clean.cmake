@@ -0,0 +1,12 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/batchTest.dir/batchTest.cpp.o"
+  "CMakeFiles/batchTest.dir/batchTest.cpp.o.d"
+  "batchTest"
+  "batchTest.pdb"
+  "batchTest[1]_tests.cmake"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/batchTest.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,12 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/blasTest.dir/blasTest.cpp.o"
+  "CMakeFiles/blasTest.dir/blasTest.cpp.o.d"
+  "blasTest"
+  "blasTest.pdb"
+  "blasTest[1]_tests.cmake"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/blasTest.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
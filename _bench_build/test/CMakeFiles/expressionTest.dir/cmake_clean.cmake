@@ -0,0 +1,12 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/expressionTest.dir/expressionTest.cpp.o"
+  "CMakeFiles/expressionTest.dir/expressionTest.cpp.o.d"
+  "expressionTest"
+  "expressionTest.pdb"
+  "expressionTest[1]_tests.cmake"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/expressionTest.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,12 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/fixed_vectorTest.dir/fixed_vectorTest.cpp.o"
+  "CMakeFiles/fixed_vectorTest.dir/fixed_vectorTest.cpp.o.d"
+  "fixed_vectorTest"
+  "fixed_vectorTest.pdb"
+  "fixed_vectorTest[1]_tests.cmake"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/fixed_vectorTest.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,12 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/halfTest.dir/halfTest.cpp.o"
+  "CMakeFiles/halfTest.dir/halfTest.cpp.o.d"
+  "halfTest"
+  "halfTest.pdb"
+  "halfTest[1]_tests.cmake"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/halfTest.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,12 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/mapped_fileTest.dir/mapped_fileTest.cpp.o"
+  "CMakeFiles/mapped_fileTest.dir/mapped_fileTest.cpp.o.d"
+  "mapped_fileTest"
+  "mapped_fileTest.pdb"
+  "mapped_fileTest[1]_tests.cmake"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/mapped_fileTest.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,12 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/parallelTest.dir/parallelTest.cpp.o"
+  "CMakeFiles/parallelTest.dir/parallelTest.cpp.o.d"
+  "parallelTest"
+  "parallelTest.pdb"
+  "parallelTest[1]_tests.cmake"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/parallelTest.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
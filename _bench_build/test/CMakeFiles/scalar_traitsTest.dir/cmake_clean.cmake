@@ -0,0 +1,12 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/scalar_traitsTest.dir/scalar_traitsTest.cpp.o"
+  "CMakeFiles/scalar_traitsTest.dir/scalar_traitsTest.cpp.o.d"
+  "scalar_traitsTest"
+  "scalar_traitsTest.pdb"
+  "scalar_traitsTest[1]_tests.cmake"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/scalar_traitsTest.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
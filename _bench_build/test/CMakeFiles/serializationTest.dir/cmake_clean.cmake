@@ -0,0 +1,12 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/serializationTest.dir/serializationTest.cpp.o"
+  "CMakeFiles/serializationTest.dir/serializationTest.cpp.o.d"
+  "serializationTest"
+  "serializationTest.pdb"
+  "serializationTest[1]_tests.cmake"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/serializationTest.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,12 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/sparse_vectorTest.dir/sparse_vectorTest.cpp.o"
+  "CMakeFiles/sparse_vectorTest.dir/sparse_vectorTest.cpp.o.d"
+  "sparse_vectorTest"
+  "sparse_vectorTest.pdb"
+  "sparse_vectorTest[1]_tests.cmake"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/sparse_vectorTest.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,12 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/split_complexTest.dir/split_complexTest.cpp.o"
+  "CMakeFiles/split_complexTest.dir/split_complexTest.cpp.o.d"
+  "split_complexTest"
+  "split_complexTest.pdb"
+  "split_complexTest[1]_tests.cmake"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/split_complexTest.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
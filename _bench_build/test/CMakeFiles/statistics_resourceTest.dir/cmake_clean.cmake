@@ -0,0 +1,12 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/statistics_resourceTest.dir/statistics_resourceTest.cpp.o"
+  "CMakeFiles/statistics_resourceTest.dir/statistics_resourceTest.cpp.o.d"
+  "statistics_resourceTest"
+  "statistics_resourceTest.pdb"
+  "statistics_resourceTest[1]_tests.cmake"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/statistics_resourceTest.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,12 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/vectorTest.dir/vectorTest.cpp.o"
+  "CMakeFiles/vectorTest.dir/vectorTest.cpp.o.d"
+  "vectorTest"
+  "vectorTest.pdb"
+  "vectorTest[1]_tests.cmake"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/vectorTest.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,20 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/test
+# Build directory: /root/repo/_bench_build/test
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+include("/root/repo/_bench_build/test/scalar_traitsTest[1]_include.cmake")
+include("/root/repo/_bench_build/test/vectorTest[1]_include.cmake")
+include("/root/repo/_bench_build/test/expressionTest[1]_include.cmake")
+include("/root/repo/_bench_build/test/parallelTest[1]_include.cmake")
+include("/root/repo/_bench_build/test/blasTest[1]_include.cmake")
+include("/root/repo/_bench_build/test/statistics_resourceTest[1]_include.cmake")
+include("/root/repo/_bench_build/test/fixed_vectorTest[1]_include.cmake")
+include("/root/repo/_bench_build/test/batchTest[1]_include.cmake")
+include("/root/repo/_bench_build/test/mapped_fileTest[1]_include.cmake")
+include("/root/repo/_bench_build/test/serializationTest[1]_include.cmake")
+include("/root/repo/_bench_build/test/sparse_vectorTest[1]_include.cmake")
+include("/root/repo/_bench_build/test/halfTest[1]_include.cmake")
+include("/root/repo/_bench_build/test/split_complexTest[1]_include.cmake")
+subdirs("extern/googletest")
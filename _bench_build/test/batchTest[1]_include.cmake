@@ -0,0 +1,5 @@
+if(EXISTS "/root/repo/_bench_build/test/batchTest[1]_tests.cmake")
+  include("/root/repo/_bench_build/test/batchTest[1]_tests.cmake")
+else()
+  add_test(batchTest_NOT_BUILT batchTest_NOT_BUILT)
+endif()
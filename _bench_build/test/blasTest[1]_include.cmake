@@ -0,0 +1,5 @@
+if(EXISTS "/root/repo/_bench_build/test/blasTest[1]_tests.cmake")
+  include("/root/repo/_bench_build/test/blasTest[1]_tests.cmake")
+else()
+  add_test(blasTest_NOT_BUILT blasTest_NOT_BUILT)
+endif()
@@ -0,0 +1,5 @@
+if(EXISTS "/root/repo/_bench_build/test/expressionTest[1]_tests.cmake")
+  include("/root/repo/_bench_build/test/expressionTest[1]_tests.cmake")
+else()
+  add_test(expressionTest_NOT_BUILT expressionTest_NOT_BUILT)
+endif()
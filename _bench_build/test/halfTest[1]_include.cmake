@@ -0,0 +1,5 @@
+if(EXISTS "/root/repo/_bench_build/test/halfTest[1]_tests.cmake")
+  include("/root/repo/_bench_build/test/halfTest[1]_tests.cmake")
+else()
+  add_test(halfTest_NOT_BUILT halfTest_NOT_BUILT)
+endif()
@@ -0,0 +1,5 @@
+if(EXISTS "/root/repo/_bench_build/test/mapped_fileTest[1]_tests.cmake")
+  include("/root/repo/_bench_build/test/mapped_fileTest[1]_tests.cmake")
+else()
+  add_test(mapped_fileTest_NOT_BUILT mapped_fileTest_NOT_BUILT)
+endif()
@@ -0,0 +1,5 @@
+if(EXISTS "/root/repo/_bench_build/test/parallelTest[1]_tests.cmake")
+  include("/root/repo/_bench_build/test/parallelTest[1]_tests.cmake")
+else()
+  add_test(parallelTest_NOT_BUILT parallelTest_NOT_BUILT)
+endif()
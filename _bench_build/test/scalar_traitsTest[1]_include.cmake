@@ -0,0 +1,5 @@
+if(EXISTS "/root/repo/_bench_build/test/scalar_traitsTest[1]_tests.cmake")
+  include("/root/repo/_bench_build/test/scalar_traitsTest[1]_tests.cmake")
+else()
+  add_test(scalar_traitsTest_NOT_BUILT scalar_traitsTest_NOT_BUILT)
+endif()
@@ -0,0 +1,5 @@
+if(EXISTS "/root/repo/_bench_build/test/serializationTest[1]_tests.cmake")
+  include("/root/repo/_bench_build/test/serializationTest[1]_tests.cmake")
+else()
+  add_test(serializationTest_NOT_BUILT serializationTest_NOT_BUILT)
+endif()
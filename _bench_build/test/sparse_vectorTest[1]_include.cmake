@@ -0,0 +1,5 @@
+if(EXISTS "/root/repo/_bench_build/test/sparse_vectorTest[1]_tests.cmake")
+  include("/root/repo/_bench_build/test/sparse_vectorTest[1]_tests.cmake")
+else()
+  add_test(sparse_vectorTest_NOT_BUILT sparse_vectorTest_NOT_BUILT)
+endif()
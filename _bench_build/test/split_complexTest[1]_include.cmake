@@ -0,0 +1,5 @@
+if(EXISTS "/root/repo/_bench_build/test/split_complexTest[1]_tests.cmake")
+  include("/root/repo/_bench_build/test/split_complexTest[1]_tests.cmake")
+else()
+  add_test(split_complexTest_NOT_BUILT split_complexTest_NOT_BUILT)
+endif()
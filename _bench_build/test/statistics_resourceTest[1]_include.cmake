@@ -0,0 +1,5 @@
+if(EXISTS "/root/repo/_bench_build/test/statistics_resourceTest[1]_tests.cmake")
+  include("/root/repo/_bench_build/test/statistics_resourceTest[1]_tests.cmake")
+else()
+  add_test(statistics_resourceTest_NOT_BUILT statistics_resourceTest_NOT_BUILT)
+endif()
@@ -0,0 +1,5 @@
+if(EXISTS "/root/repo/_bench_build/test/vectorTest[1]_tests.cmake")
+  include("/root/repo/_bench_build/test/vectorTest[1]_tests.cmake")
+else()
+  add_test(vectorTest_NOT_BUILT vectorTest_NOT_BUILT)
+endif()
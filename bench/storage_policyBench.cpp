@@ -0,0 +1,56 @@
+/*
+MIT License
+
+Copyright (c) 2022 Daisuke NAGAO
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#include <benchmark/benchmark.h>
+
+#include <dicek/linalg/vector.hpp>
+
+namespace {
+using dicek::math::linalg::synchronized_storage_policy;
+using dicek::math::linalg::unsynchronized_storage_policy;
+
+template<typename storage_policy>
+using vector = dicek::math::linalg::vector<double, dicek::math::scalar_traits<double>, storage_policy>;
+
+template<typename storage_policy>
+void BM_copy(benchmark::State& state) {
+  const vector<storage_policy> v(16);
+  for (auto _ : state) {
+    vector<storage_policy> copy = v;
+    benchmark::DoNotOptimize(copy.data());
+  }
+}
+
+/* every thread copies the same vector, so the counter's cache line bounces between cores */
+void BM_copy_contended(benchmark::State& state) {
+  static const vector<synchronized_storage_policy> v(16);
+  for (auto _ : state) {
+    vector<synchronized_storage_policy> copy = v;
+    benchmark::DoNotOptimize(copy.data());
+  }
+}
+}  // namespace
+
+BENCHMARK_TEMPLATE(BM_copy, unsynchronized_storage_policy);
+BENCHMARK_TEMPLATE(BM_copy, synchronized_storage_policy);
+BENCHMARK(BM_copy_contended)->ThreadRange(1, 8)->UseRealTime();
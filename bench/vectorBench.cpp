@@ -0,0 +1,277 @@
+/*
+MIT License
+
+Copyright (c) 2022 Daisuke NAGAO
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#include <benchmark/benchmark.h>
+
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+#include <dicek/linalg/vector.hpp>
+
+namespace {
+template<typename T>
+using vector = dicek::math::linalg::vector<T>;
+
+enum class layout { contiguous, strided, reversed, column, wide_column };
+
+/*
+ * row lengths of the matrices the column layouts walk down: with 64 every
+ * double is on its own cache line, with 1024 on its own page
+ */
+constexpr std::size_t columns      = 64;
+constexpr std::size_t wide_columns = 1024;
+
+/*
+ * n elements viewed contiguously, with step 2, with step -1, or as one
+ * column of a row-major matrix. The strided view still pulls every cache
+ * line of its 2 * n backing elements, so its effective memory traffic is
+ * twice what GB/s reports; a column costs a whole line per element.
+ */
+template<typename T>
+class operand {
+ public:
+  operand(std::size_t n, layout l) : storage_(backing_size(n, l)), view_(make_view(storage_, n, l)) {
+    for (std::size_t i = 0; i < storage_.size(); ++i) {
+      storage_[i] = static_cast<T>(1.0 + static_cast<double>(i % 7) / 8.0);
+    }
+  }
+
+  const vector<T>& view() const noexcept {
+    return view_;
+  }
+
+ private:
+  static std::size_t backing_size(std::size_t n, layout l) {
+    switch (l) {
+      case layout::strided:
+        return 2 * n;
+      case layout::column:
+        return columns * n;
+      case layout::wide_column:
+        return wide_columns * n;
+      default:
+        return n;
+    }
+  }
+
+  static vector<T> make_view(vector<T>& storage, std::size_t n, layout l) {
+    switch (l) {
+      case layout::strided:
+        return vector<T>(storage.data(), n, 2);
+      case layout::column:
+        return vector<T>(storage.data() + 1, n, static_cast<int>(columns));
+      case layout::wide_column:
+        return vector<T>(storage.data() + 1, n, static_cast<int>(wide_columns));
+      case layout::reversed:
+        return vector<T>(storage.data() + n - 1, n, -1);
+      default:
+        return vector<T>(storage.data(), n);
+    }
+  }
+
+  vector<T> storage_;
+  vector<T> view_;
+};
+
+/* streams: scalars read or written per element, e.g. 3 for z = x + y */
+template<typename T>
+void set_counters(benchmark::State& state, std::size_t streams) {
+  const double elements          = static_cast<double>(state.iterations()) * static_cast<double>(state.range(0));
+  state.counters["time/element"] = benchmark::Counter(elements, benchmark::Counter::kIsRate | benchmark::Counter::kInvert);
+  state.counters["bytes"]        = benchmark::Counter(elements * static_cast<double>(streams * sizeof(T)), benchmark::Counter::kIsRate, benchmark::Counter::OneK::kIs1000);
+}
+
+/* from L1-resident up to several times a typical last-level cache */
+void sizes(benchmark::internal::Benchmark* b) {
+  b->RangeMultiplier(8)->Range(1 << 8, 1 << 23);
+}
+
+/* columns of 2^17 and 2^13 rows already span 64 MiB of doubles */
+void column_sizes(benchmark::internal::Benchmark* b) {
+  b->RangeMultiplier(8)->Range(1 << 8, 1 << 17);
+}
+
+void wide_column_sizes(benchmark::internal::Benchmark* b) {
+  b->RangeMultiplier(8)->Range(1 << 8, 1 << 13);
+}
+
+template<typename T>
+void BM_construct(benchmark::State& state) {
+  const auto n = static_cast<std::size_t>(state.range(0));
+  for (auto _ : state) {
+    vector<T> v(n);
+    benchmark::DoNotOptimize(v.data());
+  }
+  set_counters<T>(state, 1);
+}
+
+template<typename T>
+void BM_construct_default_init(benchmark::State& state) {
+  const auto n = static_cast<std::size_t>(state.range(0));
+  for (auto _ : state) {
+    vector<T> v(n, dicek::math::linalg::default_init);
+    benchmark::DoNotOptimize(v.data());
+  }
+  set_counters<T>(state, 1);
+}
+
+/* copying shares the storage, so the cost does not depend on the size */
+template<typename T>
+void BM_share(benchmark::State& state) {
+  const vector<T> v(static_cast<std::size_t>(state.range(0)));
+  for (auto _ : state) {
+    vector<T> copy = v;
+    benchmark::DoNotOptimize(copy.data());
+  }
+}
+
+template<typename T, layout L>
+void BM_clone(benchmark::State& state) {
+  const operand<T> x(static_cast<std::size_t>(state.range(0)), L);
+  for (auto _ : state) {
+    const auto r = x.view().clone();
+    benchmark::DoNotOptimize(r.data());
+  }
+  set_counters<T>(state, 2);
+}
+
+template<typename T, layout L>
+void BM_add(benchmark::State& state) {
+  const operand<T> x(static_cast<std::size_t>(state.range(0)), L);
+  const operand<T> y(static_cast<std::size_t>(state.range(0)), L);
+  for (auto _ : state) {
+    const auto r = x.view().add(y.view());
+    benchmark::DoNotOptimize(r.data());
+  }
+  set_counters<T>(state, 3);
+}
+
+template<typename T, layout L>
+void BM_subtract(benchmark::State& state) {
+  const operand<T> x(static_cast<std::size_t>(state.range(0)), L);
+  const operand<T> y(static_cast<std::size_t>(state.range(0)), L);
+  for (auto _ : state) {
+    const auto r = x.view().subtract(y.view());
+    benchmark::DoNotOptimize(r.data());
+  }
+  set_counters<T>(state, 3);
+}
+
+template<typename T, layout L>
+void BM_scale(benchmark::State& state) {
+  const operand<T> x(static_cast<std::size_t>(state.range(0)), L);
+  for (auto _ : state) {
+    const auto r = x.view().scale(static_cast<T>(1.5));
+    benchmark::DoNotOptimize(r.data());
+  }
+  set_counters<T>(state, 2);
+}
+
+template<typename T, layout L>
+void BM_map(benchmark::State& state) {
+  const operand<T> x(static_cast<std::size_t>(state.range(0)), L);
+  for (auto _ : state) {
+    const auto r = x.view().map([](T a) { return a * a; });
+    benchmark::DoNotOptimize(r.data());
+  }
+  set_counters<T>(state, 2);
+}
+
+template<typename T, layout L>
+void BM_dot(benchmark::State& state) {
+  const operand<T> x(static_cast<std::size_t>(state.range(0)), L);
+  const operand<T> y(static_cast<std::size_t>(state.range(0)), L);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(dot(x.view(), y.view()));
+  }
+  set_counters<T>(state, 2);
+}
+
+template<typename T, layout L>
+void BM_norm1(benchmark::State& state) {
+  const operand<T> x(static_cast<std::size_t>(state.range(0)), L);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(norm1(x.view()));
+  }
+  set_counters<T>(state, 1);
+}
+
+template<typename T, layout L>
+void BM_norm2(benchmark::State& state) {
+  const operand<T> x(static_cast<std::size_t>(state.range(0)), L);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(norm2(x.view()));
+  }
+  set_counters<T>(state, 1);
+}
+
+template<typename T, layout L>
+void BM_norm_inf(benchmark::State& state) {
+  const operand<T> x(static_cast<std::size_t>(state.range(0)), L);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(norm_inf(x.view()));
+  }
+  set_counters<T>(state, 1);
+}
+
+/* p = 3 is not forwarded to a fast path, so this measures the general pow loop */
+template<typename T, layout L>
+void BM_norm_p(benchmark::State& state) {
+  const operand<T> x(static_cast<std::size_t>(state.range(0)), L);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(norm(x.view(), 3));
+  }
+  set_counters<T>(state, 1);
+}
+}  // namespace
+
+#define DICEK_BENCHMARK_TYPES(func)                            \
+  BENCHMARK_TEMPLATE(func, float)->Apply(sizes);               \
+  BENCHMARK_TEMPLATE(func, double)->Apply(sizes);              \
+  BENCHMARK_TEMPLATE(func, std::complex<double>)->Apply(sizes)
+
+#define DICEK_BENCHMARK_LAYOUTS(func, type)                            \
+  BENCHMARK_TEMPLATE(func, type, layout::contiguous)->Apply(sizes);    \
+  BENCHMARK_TEMPLATE(func, type, layout::strided)->Apply(sizes);       \
+  BENCHMARK_TEMPLATE(func, type, layout::reversed)->Apply(sizes);      \
+  BENCHMARK_TEMPLATE(func, type, layout::column)->Apply(column_sizes); \
+  BENCHMARK_TEMPLATE(func, type, layout::wide_column)->Apply(wide_column_sizes)
+
+#define DICEK_BENCHMARK_ALL(func)                     \
+  DICEK_BENCHMARK_LAYOUTS(func, float);               \
+  DICEK_BENCHMARK_LAYOUTS(func, double);              \
+  DICEK_BENCHMARK_LAYOUTS(func, std::complex<double>)
+
+DICEK_BENCHMARK_TYPES(BM_construct);
+DICEK_BENCHMARK_TYPES(BM_construct_default_init);
+BENCHMARK_TEMPLATE(BM_share, double)->Arg(1 << 8);
+DICEK_BENCHMARK_ALL(BM_clone);
+DICEK_BENCHMARK_ALL(BM_add);
+DICEK_BENCHMARK_ALL(BM_subtract);
+DICEK_BENCHMARK_ALL(BM_scale);
+DICEK_BENCHMARK_ALL(BM_map);
+DICEK_BENCHMARK_ALL(BM_dot);
+DICEK_BENCHMARK_ALL(BM_norm1);
+DICEK_BENCHMARK_ALL(BM_norm2);
+DICEK_BENCHMARK_ALL(BM_norm_inf);
+DICEK_BENCHMARK_ALL(BM_norm_p);
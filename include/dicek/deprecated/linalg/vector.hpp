@@ -32,6 +32,7 @@ SOFTWARE.
 namespace dicek {
 namespace math {
 namespace linalg {
+/* deprecated: use fixed_vector in dicek/linalg/fixed_vector.hpp */
 template<unsigned long _DIM, typename _scalar_type, typename _scalar_traits = scalar_traits<_scalar_type>>
 class vector : public vector_base<vector<_DIM, _scalar_type, _scalar_traits>, _scalar_type, _scalar_traits> {
  public:
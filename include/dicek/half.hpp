@@ -0,0 +1,227 @@
+/*
+MIT License
+
+Copyright (c) 2016 Daisuke NAGAO
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#ifndef UUID_2B52F85A_F466_4237_9468_08721893A673
+#define UUID_2B52F85A_F466_4237_9468_08721893A673
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <dicek/scalar_traits.hpp>
+#include <type_traits>
+
+namespace dicek::math {
+namespace detail {
+inline std::uint32_t float_bits(float val) noexcept {
+  std::uint32_t bits;
+  std::memcpy(&bits, &val, sizeof(bits));
+  return bits;
+}
+
+inline float bits_float(std::uint32_t bits) noexcept {
+  float val;
+  std::memcpy(&val, &bits, sizeof(val));
+  return val;
+}
+
+/* rounds bits >> shift to nearest, ties to even */
+constexpr std::uint32_t round_shift(std::uint32_t bits, unsigned shift) noexcept {
+  const std::uint32_t half_ulp = std::uint32_t(1) << (shift - 1);
+  const std::uint32_t rest     = bits & ((std::uint32_t(1) << shift) - 1);
+  const std::uint32_t ret      = bits >> shift;
+  return ret + (rest > half_ulp || (rest == half_ulp && (ret & 1) != 0) ? 1 : 0);
+}
+}  // namespace detail
+
+/*
+ * IEEE 754 binary16, for storage only.
+ *
+ * A half converts implicitly to and from float and all arithmetic is done in
+ * float; converting from float rounds to nearest, ties to even, and
+ * overflows to infinity. The reduction kernels widen halves to float as
+ * they load them.
+ */
+class half {
+ public:
+  half() = default;
+
+  half(float val) noexcept : bits_(from_float(val)) {}
+
+  static half from_bits(std::uint16_t bits) noexcept {
+    half ret;
+    ret.bits_ = bits;
+    return ret;
+  }
+
+  std::uint16_t bits() const noexcept {
+    return bits_;
+  }
+
+  operator float() const noexcept {
+    const std::uint32_t sign     = std::uint32_t(bits_ & 0x8000u) << 16;
+    const std::uint32_t exponent = (bits_ >> 10) & 0x1fu;
+    const std::uint32_t mantissa = bits_ & 0x3ffu;
+    if (exponent == 0x1f) {
+      return detail::bits_float(sign | 0x7f800000u | (mantissa << 13));
+    }
+    if (exponent == 0) {
+      /* zero or subnormal: mantissa * 2^-24 is exact in float */
+      const float magnitude = static_cast<float>(mantissa) * 0x1p-24f;
+      return sign != 0 ? -magnitude : magnitude;
+    }
+    return detail::bits_float(sign | ((exponent + 112) << 23) | (mantissa << 13));
+  }
+
+  half& operator+=(float rhs) noexcept {
+    return *this = static_cast<float>(*this) + rhs;
+  }
+  half& operator-=(float rhs) noexcept {
+    return *this = static_cast<float>(*this) - rhs;
+  }
+  half& operator*=(float rhs) noexcept {
+    return *this = static_cast<float>(*this) * rhs;
+  }
+  half& operator/=(float rhs) noexcept {
+    return *this = static_cast<float>(*this) / rhs;
+  }
+
+ private:
+  static std::uint16_t from_float(float val) noexcept {
+    std::uint32_t f          = detail::float_bits(val);
+    const std::uint32_t sign = (f >> 16) & 0x8000u;
+    f &= 0x7fffffffu;
+    if (f >= 0x7f800000u) {
+      /* infinity, or NaN kept quiet with the top of its payload */
+      return static_cast<std::uint16_t>(sign | 0x7c00u | (f > 0x7f800000u ? 0x200u | ((f >> 13) & 0x3ffu) : 0));
+    }
+    if (f >= 0x477ff000u) {
+      /* 65520 and above round to infinity */
+      return static_cast<std::uint16_t>(sign | 0x7c00u);
+    }
+    if (f < 0x38800000u) {
+      /* below 2^-14: subnormal, with the implicit bit made explicit; 2^-25 and below round to zero */
+      if (f <= 0x33000000u) {
+        return static_cast<std::uint16_t>(sign);
+      }
+      const std::uint32_t exponent = f >> 23;
+      return static_cast<std::uint16_t>(sign | detail::round_shift((f & 0x7fffffu) | 0x800000u, 126 - exponent));
+    }
+    /* rebias the exponent from 127 to 15; a carry out of the mantissa correctly bumps the exponent */
+    return static_cast<std::uint16_t>(sign | detail::round_shift(f - 0x38000000u, 13));
+  }
+
+  std::uint16_t bits_;
+};
+
+/*
+ * bfloat16 (the upper half of a float), for storage only.
+ *
+ * Behaves like half, but keeps float's exponent range with an 8-bit
+ * significand, so widening it is a 16-bit shift.
+ */
+class bfloat16 {
+ public:
+  bfloat16() = default;
+
+  bfloat16(float val) noexcept : bits_(from_float(val)) {}
+
+  static bfloat16 from_bits(std::uint16_t bits) noexcept {
+    bfloat16 ret;
+    ret.bits_ = bits;
+    return ret;
+  }
+
+  std::uint16_t bits() const noexcept {
+    return bits_;
+  }
+
+  operator float() const noexcept {
+    return detail::bits_float(std::uint32_t(bits_) << 16);
+  }
+
+  bfloat16& operator+=(float rhs) noexcept {
+    return *this = static_cast<float>(*this) + rhs;
+  }
+  bfloat16& operator-=(float rhs) noexcept {
+    return *this = static_cast<float>(*this) - rhs;
+  }
+  bfloat16& operator*=(float rhs) noexcept {
+    return *this = static_cast<float>(*this) * rhs;
+  }
+  bfloat16& operator/=(float rhs) noexcept {
+    return *this = static_cast<float>(*this) / rhs;
+  }
+
+ private:
+  static std::uint16_t from_float(float val) noexcept {
+    const std::uint32_t f = detail::float_bits(val);
+    if ((f & 0x7fffffffu) > 0x7f800000u) {
+      return static_cast<std::uint16_t>((f >> 16) | 0x40u);
+    }
+    return static_cast<std::uint16_t>(detail::round_shift(f, 16));
+  }
+
+  std::uint16_t bits_;
+};
+
+static_assert(sizeof(half) == 2 && std::is_trivial_v<half>, "half must be a trivial 16-bit type");
+static_assert(sizeof(bfloat16) == 2 && std::is_trivial_v<bfloat16>, "bfloat16 must be a trivial 16-bit type");
+
+template<>
+struct is_storage_only<half> : std::true_type {};
+
+template<>
+struct is_storage_only<bfloat16> : std::true_type {};
+
+template<>
+struct scalar_traits<half> {
+  using scalar_type      = half;
+  using accumulator_type = float;
+  using kernel_type      = half;
+
+  static scalar_type conj(scalar_type val) {
+    return val;
+  }
+
+  static float abs(scalar_type val) {
+    return std::abs(static_cast<float>(val));
+  }
+};
+
+template<>
+struct scalar_traits<bfloat16> {
+  using scalar_type      = bfloat16;
+  using accumulator_type = float;
+  using kernel_type      = bfloat16;
+
+  static scalar_type conj(scalar_type val) {
+    return val;
+  }
+
+  static float abs(scalar_type val) {
+    return std::abs(static_cast<float>(val));
+  }
+};
+}  // namespace dicek::math
+
+#endif /* UUID_2B52F85A_F466_4237_9468_08721893A673 */
@@ -0,0 +1,251 @@
+/*
+MIT License
+
+Copyright (c) 2022 Daisuke NAGAO
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#ifndef UUID_2C708D17_A646_46FA_8A55_837E1008DBB3
+#define UUID_2C708D17_A646_46FA_8A55_837E1008DBB3
+
+#include <climits>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <dicek/linalg/fixed_vector.hpp>
+#include <dicek/linalg/storage_policy.hpp>
+#include <dicek/linalg/vector.hpp>
+#include <memory_resource>
+#include <stdexcept>
+#include <string>
+
+namespace dicek::math::linalg {
+/*
+ * count vectors of dimension N stored as structure of arrays: component k of
+ * every vector is contiguous, so bulk operations run one vectorizable loop
+ * across the batch instead of one short loop per vector.
+ *
+ * Components start on cache-line boundaries; component(k) views them as
+ * contiguous vectors and element(i) views one vector as a strided vector, so
+ * the dynamic vector's free functions work on either. Like vector, copies of
+ * a batch share its storage.
+ */
+template<typename T, std::size_t N, typename scalar_traits = dicek::math::scalar_traits<T>>
+class vector_batch {
+ public:
+  using scalar_traits_type = scalar_traits;
+  using scalar_type        = typename scalar_traits::scalar_type;
+  using vector_type        = vector<T, scalar_traits>;
+  using value_type         = fixed_vector<T, N, scalar_traits>;
+
+  static constexpr std::size_t dimension = N;
+
+  vector_batch() : vector_batch(0) {}
+
+  /* count zero vectors */
+  explicit vector_batch(std::size_t count, std::pmr::memory_resource* alloc = std::pmr::get_default_resource()) : count_(count), ld_(leading_dimension(count)), storage_(N * ld_, alloc) {}
+
+  std::size_t size() const noexcept {
+    return count_;
+  }
+
+  std::pmr::memory_resource* get_allocator() const noexcept {
+    return storage_.get_allocator();
+  }
+
+  value_type operator[](std::size_t i) const {
+    value_type v;
+    for (std::size_t k = 0; k < N; ++k) {
+      v[k] = component_data(k)[i];
+    }
+    return v;
+  }
+
+  void set(std::size_t i, const value_type& v) {
+    for (std::size_t k = 0; k < N; ++k) {
+      component_data(k)[i] = v[k];
+    }
+  }
+
+  /* contiguous view of component k of every vector */
+  vector_type component(std::size_t k) {
+    validate_component(k);
+    return vector_type(component_data(k), count_);
+  }
+
+  /* vector has no read-only view: the views of a const batch must not be written through */
+  vector_type component(std::size_t k) const {
+    return const_cast<vector_batch*>(this)->component(k);
+  }
+
+  /* strided view of the N components of vector i */
+  vector_type element(std::size_t i) {
+    if (i >= count_) {
+      throw std::out_of_range("vector_batch::element: i >= this->size()");
+    }
+    if (ld_ > static_cast<std::size_t>(INT_MAX)) {
+      throw std::length_error("vector_batch::element: batch too large for a strided view");
+    }
+    return vector_type(component_data(0) + i, N, static_cast<int>(ld_));
+  }
+
+  vector_type element(std::size_t i) const {
+    return const_cast<vector_batch*>(this)->element(i);
+  }
+
+  scalar_type* component_data(std::size_t k) noexcept {
+    return storage_.data() + k * ld_;
+  }
+
+  const scalar_type* component_data(std::size_t k) const noexcept {
+    return storage_.data() + k * ld_;
+  }
+
+ private:
+  using storage_type = vector<T, scalar_traits, aligned_storage_policy<64>>;
+
+  static std::size_t leading_dimension(std::size_t count) {
+    constexpr std::size_t per_line = sizeof(scalar_type) < 64 ? 64 / sizeof(scalar_type) : 1;
+    if (count > SIZE_MAX / N - per_line) {
+      throw std::bad_array_new_length();
+    }
+    return (count + per_line - 1) / per_line * per_line;
+  }
+
+  void validate_component(std::size_t k) const {
+    if (k >= N) {
+      throw std::out_of_range("vector_batch::component: k >= N");
+    }
+  }
+
+  std::size_t count_;
+  std::size_t ld_;
+  storage_type storage_;
+};
+
+namespace detail {
+template<typename B, typename... Bs>
+void validate_same_count(const char* name, std::size_t count, const B& b, const Bs&... bs) {
+  if (b.size() != count || ((bs.size() != count) || ...)) {
+    throw std::invalid_argument(std::string(name) + ": size mismatch");
+  }
+}
+}  // namespace detail
+
+/* out[i] = dot(a[i], b[i]) */
+template<typename T, std::size_t N, typename scalar_traits, typename storage_policy>
+vector<T, scalar_traits, storage_policy>& dot(const vector_batch<T, N, scalar_traits>& a, const vector_batch<T, N, scalar_traits>& b, vector<T, scalar_traits, storage_policy>& out) {
+  detail::validate_same_count("vector_batch dot", a.size(), b, out);
+  for (std::size_t i = 0; i < a.size(); ++i) {
+    typename vector_batch<T, N, scalar_traits>::scalar_type sum = {};
+    for (std::size_t k = 0; k < N; ++k) {
+      sum += a.component_data(k)[i] * scalar_traits::conj(b.component_data(k)[i]);
+    }
+    out[i] = sum;
+  }
+  return out;
+}
+
+/* out[i] = norm2(a[i]), from the direct sum of squares without rescaling */
+template<typename T, std::size_t N, typename scalar_traits, typename storage_policy>
+vector<T, scalar_traits, storage_policy>& norm2(const vector_batch<T, N, scalar_traits>& a, vector<T, scalar_traits, storage_policy>& out) {
+  using std::sqrt;
+  detail::validate_same_count("vector_batch norm2", a.size(), out);
+  for (std::size_t i = 0; i < a.size(); ++i) {
+    decltype(scalar_traits::abs(a.component_data(0)[i])) ssq = {};
+    for (std::size_t k = 0; k < N; ++k) {
+      const auto x = scalar_traits::abs(a.component_data(k)[i]);
+      ssq += x * x;
+    }
+    out[i] = sqrt(ssq);
+  }
+  return out;
+}
+
+/* a[i] /= norm2(a[i]); zero vectors stay zero */
+template<typename T, std::size_t N, typename scalar_traits>
+void normalize(vector_batch<T, N, scalar_traits>& a) {
+  using std::sqrt;
+  for (std::size_t i = 0; i < a.size(); ++i) {
+    decltype(scalar_traits::abs(a.component_data(0)[i])) ssq = {};
+    for (std::size_t k = 0; k < N; ++k) {
+      const auto x = scalar_traits::abs(a.component_data(k)[i]);
+      ssq += x * x;
+    }
+    if (ssq != 0) {
+      const auto inv = 1 / sqrt(ssq);
+      for (std::size_t k = 0; k < N; ++k) {
+        a.component_data(k)[i] *= inv;
+      }
+    }
+  }
+}
+
+/* out[i] = a[i] + b[i]; out may be a or b */
+template<typename T, std::size_t N, typename scalar_traits>
+void add(const vector_batch<T, N, scalar_traits>& a, const vector_batch<T, N, scalar_traits>& b, vector_batch<T, N, scalar_traits>& out) {
+  detail::validate_same_count("vector_batch add", a.size(), b, out);
+  for (std::size_t k = 0; k < N; ++k) {
+    const auto* pa = a.component_data(k);
+    const auto* pb = b.component_data(k);
+    auto* po       = out.component_data(k);
+    for (std::size_t i = 0; i < a.size(); ++i) {
+      po[i] = pa[i] + pb[i];
+    }
+  }
+}
+
+/* y[i] += alpha * x[i] */
+template<typename T, std::size_t N, typename scalar_traits>
+void axpy(typename vector_batch<T, N, scalar_traits>::scalar_type alpha, const vector_batch<T, N, scalar_traits>& x, vector_batch<T, N, scalar_traits>& y) {
+  detail::validate_same_count("vector_batch axpy", x.size(), y);
+  for (std::size_t k = 0; k < N; ++k) {
+    const auto* px = x.component_data(k);
+    auto* py       = y.component_data(k);
+    for (std::size_t i = 0; i < x.size(); ++i) {
+      py[i] += alpha * px[i];
+    }
+  }
+}
+
+/* out[i] = cross(a[i], b[i]); out may be a or b */
+template<typename T, typename scalar_traits>
+void cross(const vector_batch<T, 3, scalar_traits>& a, const vector_batch<T, 3, scalar_traits>& b, vector_batch<T, 3, scalar_traits>& out) {
+  detail::validate_same_count("vector_batch cross", a.size(), b, out);
+  const auto* ax = a.component_data(0);
+  const auto* ay = a.component_data(1);
+  const auto* az = a.component_data(2);
+  const auto* bx = b.component_data(0);
+  const auto* by = b.component_data(1);
+  const auto* bz = b.component_data(2);
+  auto* ox       = out.component_data(0);
+  auto* oy       = out.component_data(1);
+  auto* oz       = out.component_data(2);
+  for (std::size_t i = 0; i < a.size(); ++i) {
+    const auto x = ay[i] * bz[i] - az[i] * by[i];
+    const auto y = az[i] * bx[i] - ax[i] * bz[i];
+    const auto z = ax[i] * by[i] - ay[i] * bx[i];
+    ox[i]        = x;
+    oy[i]        = y;
+    oz[i]        = z;
+  }
+}
+}  // namespace dicek::math::linalg
+
+#endif /* UUID_2C708D17_A646_46FA_8A55_837E1008DBB3 */
@@ -0,0 +1,164 @@
+/*
+MIT License
+
+Copyright (c) 2022 Daisuke NAGAO
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#ifndef UUID_8254BF02_0D21_4867_9B9F_8C1BA134F64B
+#define UUID_8254BF02_0D21_4867_9B9F_8C1BA134F64B
+
+#include <algorithm>
+#include <cstddef>
+#include <dicek/linalg/detail/kernels.hpp>
+#include <dicek/linalg/vector.hpp>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+namespace dicek::math::linalg::blas {
+/*
+ * BLAS level-1 routines working in place on (possibly strided) vectors.
+ *
+ * Each routine makes one pass over its operands and allocates nothing,
+ * except when the operands partially overlap: then, as in vector::operator+=,
+ * the operands that are read are snapshotted first. Operands visiting exactly
+ * the same elements are processed element by element without a snapshot.
+ *
+ * blas::swap exchanges elements; the unqualified swap(x, y) found by ADL
+ * still exchanges the vectors themselves.
+ */
+namespace detail {
+template<typename V>
+void validate_same_size(const V& x, const V& y, const char* name) {
+  if (x.size() != y.size()) {
+    throw std::invalid_argument(std::string(name) + ": size mismatch");
+  }
+}
+
+template<typename V>
+bool partially_overlap(const V& x, const V& y) noexcept {
+  return linalg::detail::vector_access::overlaps_partially(x, y);
+}
+
+template<typename V>
+bool identical_element_mapping(const V& x, const V& y) noexcept {
+  return linalg::detail::vector_access::has_identical_element_mapping(x, y);
+}
+
+template<typename V>
+V snapshot(const V& x) {
+  return linalg::detail::vector_access::snapshot(x);
+}
+}  // namespace detail
+
+/* y = a * x + y */
+template<typename T, typename scalar_traits, typename storage_policy>
+void axpy(typename vector<T, scalar_traits, storage_policy>::scalar_type a, const vector<T, scalar_traits, storage_policy>& x, vector<T, scalar_traits, storage_policy>& y) {
+  detail::validate_same_size(x, y, "blas::axpy");
+  if (detail::partially_overlap(x, y)) {
+    axpy(a, detail::snapshot(x), y);
+  } else if (x.is_contiguous() && y.is_contiguous()) {
+    linalg::detail::axpy(linalg::detail::kernel_value<scalar_traits>(a), linalg::detail::kernel_pointer<scalar_traits>(x.data()), linalg::detail::kernel_pointer<scalar_traits>(y.data()), y.size());
+  } else {
+    with_ranges([a](auto first, auto last, auto out) { std::transform(first, last, out, out, [a](const auto& xi, const auto& yi) { return yi + a * xi; }); }, x, y);
+  }
+}
+
+/* y = a * x + b * y */
+template<typename T, typename scalar_traits, typename storage_policy>
+void axpby(typename vector<T, scalar_traits, storage_policy>::scalar_type a, const vector<T, scalar_traits, storage_policy>& x, typename vector<T, scalar_traits, storage_policy>::scalar_type b, vector<T, scalar_traits, storage_policy>& y) {
+  detail::validate_same_size(x, y, "blas::axpby");
+  if (detail::partially_overlap(x, y)) {
+    axpby(a, detail::snapshot(x), b, y);
+  } else if (x.is_contiguous() && y.is_contiguous()) {
+    linalg::detail::axpby(linalg::detail::kernel_value<scalar_traits>(a), linalg::detail::kernel_pointer<scalar_traits>(x.data()), linalg::detail::kernel_value<scalar_traits>(b),
+                          linalg::detail::kernel_pointer<scalar_traits>(y.data()), y.size());
+  } else {
+    with_ranges([a, b](auto first, auto last, auto out) { std::transform(first, last, out, out, [a, b](const auto& xi, const auto& yi) { return a * xi + b * yi; }); }, x, y);
+  }
+}
+
+/* y = x */
+template<typename T, typename scalar_traits, typename storage_policy>
+void copy(const vector<T, scalar_traits, storage_policy>& x, vector<T, scalar_traits, storage_policy>& y) {
+  detail::validate_same_size(x, y, "blas::copy");
+  if (detail::identical_element_mapping(x, y)) {
+    return;
+  } else if (detail::partially_overlap(x, y)) {
+    copy(detail::snapshot(x), y);
+  } else {
+    with_ranges([](auto first, auto last, auto out) { std::copy(first, last, out); }, x, y);
+  }
+}
+
+/* exchanges the elements of x and y; where they overlap, x's old values win */
+template<typename T, typename scalar_traits, typename storage_policy>
+void swap(vector<T, scalar_traits, storage_policy>& x, vector<T, scalar_traits, storage_policy>& y) {
+  detail::validate_same_size(x, y, "blas::swap");
+  if (detail::identical_element_mapping(x, y)) {
+    return;
+  } else if (detail::partially_overlap(x, y)) {
+    const auto x_copy = detail::snapshot(x);
+    copy(detail::snapshot(y), x);
+    copy(x_copy, y);
+  } else {
+    with_ranges([](auto first, auto last, auto out) { std::swap_ranges(first, last, out); }, x, y);
+  }
+}
+
+/* x = a * x */
+template<typename T, typename scalar_traits, typename storage_policy>
+void scal(typename vector<T, scalar_traits, storage_policy>::scalar_type a, vector<T, scalar_traits, storage_policy>& x) {
+  if (x.is_contiguous()) {
+    linalg::detail::scale(linalg::detail::kernel_pointer<scalar_traits>(x.data()), linalg::detail::kernel_value<scalar_traits>(a), linalg::detail::kernel_pointer<scalar_traits>(x.data()), x.size());
+  } else {
+    with_ranges([a](auto first, auto last) { std::for_each(first, last, [a](auto& xi) { xi *= a; }); }, x);
+  }
+}
+
+/* Givens rotation: (x, y) = (c * x + s * y, c * y - s * x); where they overlap, y's new values win */
+template<typename T, typename scalar_traits, typename storage_policy, typename real_type = decltype(scalar_traits::abs(std::declval<typename vector<T, scalar_traits, storage_policy>::scalar_type>()))>
+void rot(vector<T, scalar_traits, storage_policy>& x, vector<T, scalar_traits, storage_policy>& y, real_type c, real_type s) {
+  detail::validate_same_size(x, y, "blas::rot");
+  if (detail::partially_overlap(x, y)) {
+    const auto x_copy = detail::snapshot(x);
+    const auto y_copy = detail::snapshot(y);
+    for (std::size_t i = 0; i < y.size(); ++i) {
+      x[i] = c * x_copy[i] + s * y_copy[i];
+    }
+    for (std::size_t i = 0; i < y.size(); ++i) {
+      y[i] = c * y_copy[i] - s * x_copy[i];
+    }
+  } else {
+    with_ranges(
+        [c, s](auto first, auto last, auto py) {
+          for (auto px = first; px != last; ++px, ++py) {
+            const auto xi = *px;
+            const auto yi = *py;
+            *px           = c * xi + s * yi;
+            *py           = c * yi - s * xi;
+          }
+        },
+        x, y);
+  }
+}
+}  // namespace dicek::math::linalg::blas
+
+#endif /* UUID_8254BF02_0D21_4867_9B9F_8C1BA134F64B */
@@ -0,0 +1,946 @@
+/*
+MIT License
+
+Copyright (c) 2022 Daisuke NAGAO
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#ifndef UUID_EC915F6F_218C_444C_8A6F_FD09D00625A9
+#define UUID_EC915F6F_218C_444C_8A6F_FD09D00625A9
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <dicek/half.hpp>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+#if defined(__AVX512F__) || defined(__AVX2__) || defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <immintrin.h>
+#endif
+
+namespace dicek::math::linalg::detail {
+/*
+ * Kernels for contiguous (step == 1) float and double buffers.
+ *
+ * The reductions take an accumulator type A: simd<A>::load also reads
+ * narrower elements (float into double, half and bfloat16 into float) and
+ * widens them, so the conversion costs no extra pass over memory.
+ *
+ * simd<T> wraps the widest instruction set enabled at compile time
+ * (AVX-512F, AVX2, then SSE2); gather and scatter take 32-bit indices that
+ * are read as signed offsets. When it is not defined for T, the kernels
+ * fall back to plain loops, which still keep several independent
+ * accumulators for reductions.
+ */
+template<typename T>
+struct simd;
+
+/* widening load for instruction sets without a conversion instruction: convert lane by lane and reload */
+template<typename reg, typename To, typename From>
+reg load_lanes(const From* p) {
+  constexpr std::size_t width = sizeof(reg) / sizeof(To);
+  alignas(reg) To lanes[width];
+  for (std::size_t k = 0; k < width; ++k) {
+    lanes[k] = static_cast<To>(p[k]);
+  }
+  reg ret;
+  std::memcpy(&ret, lanes, sizeof(reg));
+  return ret;
+}
+
+/* scatter for instruction sets without one: spill the register and store lane by lane */
+template<typename T, typename reg>
+void scatter_lanes(T* base, const std::uint32_t* idx, reg x) {
+  constexpr std::size_t width = sizeof(reg) / sizeof(T);
+  alignas(reg) T lanes[width];
+  std::memcpy(lanes, &x, sizeof(reg));
+  for (std::size_t k = 0; k < width; ++k) {
+    base[static_cast<std::int32_t>(idx[k])] = lanes[k];
+  }
+}
+
+#if defined(__AVX512F__)
+template<>
+struct simd<double> {
+  using reg                          = __m512d;
+  static constexpr std::size_t width = 8;
+
+  static reg zero() {
+    return _mm512_setzero_pd();
+  }
+  static reg set1(double x) {
+    return _mm512_set1_pd(x);
+  }
+  static reg load(const double* p) {
+    return _mm512_loadu_pd(p);
+  }
+  /* widening loads read width narrower elements; the masked forms with a zero source avoid GCC's uninitialized warnings */
+  static reg load(const float* p) {
+    return _mm512_maskz_cvtps_pd(0xFF, _mm256_loadu_ps(p));
+  }
+  static void store(double* p, reg x) {
+    _mm512_storeu_pd(p, x);
+  }
+  static reg add(reg x, reg y) {
+    return _mm512_add_pd(x, y);
+  }
+  static reg sub(reg x, reg y) {
+    return _mm512_sub_pd(x, y);
+  }
+  static reg mul(reg x, reg y) {
+    return _mm512_mul_pd(x, y);
+  }
+  static reg abs(reg x) {
+    return _mm512_abs_pd(x);
+  }
+  static reg fmadd(reg x, reg y, reg acc) {
+    return _mm512_fmadd_pd(x, y, acc);
+  }
+  /* _mm512_reduce_add_pd and _mm512_castpd512_pd256 extract through an undefined register, which GCC warns about; zero-masked extracts do not */
+  static double reduce(reg x) {
+    const __m256d quad = _mm256_add_pd(_mm512_maskz_extractf64x4_pd(0xF, x, 0), _mm512_maskz_extractf64x4_pd(0xF, x, 1));
+    const __m128d sum  = _mm_add_pd(_mm256_castpd256_pd128(quad), _mm256_extractf128_pd(quad, 1));
+    return _mm_cvtsd_f64(_mm_add_sd(sum, _mm_unpackhi_pd(sum, sum)));
+  }
+  /* the masked forms with a zero source avoid GCC's uninitialized warnings on the plain ones */
+  static reg gather(const double* base, const std::uint32_t* idx) {
+    return _mm512_mask_i32gather_pd(_mm512_setzero_pd(), 0xFF, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(idx)), base, 8);
+  }
+  static reg gather(const float* base, const std::uint32_t* idx) {
+    return _mm512_maskz_cvtps_pd(0xFF, _mm256_mask_i32gather_ps(_mm256_setzero_ps(), base, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(idx)), _mm256_castsi256_ps(_mm256_set1_epi32(-1)), 4));
+  }
+  static void scatter(double* base, const std::uint32_t* idx, reg x) {
+    _mm512_i32scatter_pd(base, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(idx)), x, 8);
+  }
+};
+
+template<>
+struct simd<float> {
+  using reg                          = __m512;
+  static constexpr std::size_t width = 16;
+
+  static reg zero() {
+    return _mm512_setzero_ps();
+  }
+  static reg set1(float x) {
+    return _mm512_set1_ps(x);
+  }
+  static reg load(const float* p) {
+    return _mm512_loadu_ps(p);
+  }
+  static reg load(const half* p) {
+    return _mm512_maskz_cvtph_ps(0xFFFF, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)));
+  }
+  static reg load(const bfloat16* p) {
+    return _mm512_castsi512_ps(_mm512_maskz_slli_epi32(0xFFFF, _mm512_maskz_cvtepu16_epi32(0xFFFF, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p))), 16));
+  }
+  static void store(float* p, reg x) {
+    _mm512_storeu_ps(p, x);
+  }
+  static reg add(reg x, reg y) {
+    return _mm512_add_ps(x, y);
+  }
+  static reg sub(reg x, reg y) {
+    return _mm512_sub_ps(x, y);
+  }
+  static reg mul(reg x, reg y) {
+    return _mm512_mul_ps(x, y);
+  }
+  static reg abs(reg x) {
+    return _mm512_abs_ps(x);
+  }
+  static reg fmadd(reg x, reg y, reg acc) {
+    return _mm512_fmadd_ps(x, y, acc);
+  }
+  /* as for double; _mm512_maskz_extractf32x8_ps would need AVX512DQ, so the halves are extracted as doubles */
+  static float reduce(reg x) {
+    const __m512d bits = _mm512_castps_pd(x);
+    const __m256 oct   = _mm256_add_ps(_mm256_castpd_ps(_mm512_maskz_extractf64x4_pd(0xF, bits, 0)), _mm256_castpd_ps(_mm512_maskz_extractf64x4_pd(0xF, bits, 1)));
+    __m128 sum         = _mm_add_ps(_mm256_castps256_ps128(oct), _mm256_extractf128_ps(oct, 1));
+    sum                = _mm_add_ps(sum, _mm_movehl_ps(sum, sum));
+    return _mm_cvtss_f32(_mm_add_ss(sum, _mm_shuffle_ps(sum, sum, 1)));
+  }
+  static reg gather(const float* base, const std::uint32_t* idx) {
+    return _mm512_mask_i32gather_ps(_mm512_setzero_ps(), 0xFFFF, _mm512_loadu_si512(idx), base, 4);
+  }
+  static void scatter(float* base, const std::uint32_t* idx, reg x) {
+    _mm512_i32scatter_ps(base, _mm512_loadu_si512(idx), x, 4);
+  }
+};
+#elif defined(__AVX2__)
+template<>
+struct simd<double> {
+  using reg                          = __m256d;
+  static constexpr std::size_t width = 4;
+
+  static reg zero() {
+    return _mm256_setzero_pd();
+  }
+  static reg set1(double x) {
+    return _mm256_set1_pd(x);
+  }
+  static reg load(const double* p) {
+    return _mm256_loadu_pd(p);
+  }
+  /* widening loads read width narrower elements */
+  static reg load(const float* p) {
+    return _mm256_cvtps_pd(_mm_loadu_ps(p));
+  }
+  static void store(double* p, reg x) {
+    _mm256_storeu_pd(p, x);
+  }
+  static reg add(reg x, reg y) {
+    return _mm256_add_pd(x, y);
+  }
+  static reg sub(reg x, reg y) {
+    return _mm256_sub_pd(x, y);
+  }
+  static reg mul(reg x, reg y) {
+    return _mm256_mul_pd(x, y);
+  }
+  static reg abs(reg x) {
+    return _mm256_andnot_pd(_mm256_set1_pd(-0.0), x);
+  }
+  static reg fmadd(reg x, reg y, reg acc) {
+#if defined(__FMA__)
+    return _mm256_fmadd_pd(x, y, acc);
+#else
+    return _mm256_add_pd(_mm256_mul_pd(x, y), acc);
+#endif
+  }
+  static double reduce(reg x) {
+    const __m128d sum = _mm_add_pd(_mm256_castpd256_pd128(x), _mm256_extractf128_pd(x, 1));
+    return _mm_cvtsd_f64(_mm_add_sd(sum, _mm_unpackhi_pd(sum, sum)));
+  }
+  static reg gather(const double* base, const std::uint32_t* idx) {
+    return _mm256_mask_i32gather_pd(_mm256_setzero_pd(), base, _mm_loadu_si128(reinterpret_cast<const __m128i*>(idx)), _mm256_castsi256_pd(_mm256_set1_epi64x(-1)), 8);
+  }
+  static reg gather(const float* base, const std::uint32_t* idx) {
+    return _mm256_cvtps_pd(_mm_mask_i32gather_ps(_mm_setzero_ps(), base, _mm_loadu_si128(reinterpret_cast<const __m128i*>(idx)), _mm_castsi128_ps(_mm_set1_epi32(-1)), 4));
+  }
+  static void scatter(double* base, const std::uint32_t* idx, reg x) {
+    scatter_lanes(base, idx, x);
+  }
+};
+
+template<>
+struct simd<float> {
+  using reg                          = __m256;
+  static constexpr std::size_t width = 8;
+
+  static reg zero() {
+    return _mm256_setzero_ps();
+  }
+  static reg set1(float x) {
+    return _mm256_set1_ps(x);
+  }
+  static reg load(const float* p) {
+    return _mm256_loadu_ps(p);
+  }
+  static reg load(const half* p) {
+#if defined(__F16C__)
+    return _mm256_cvtph_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p)));
+#else
+    return load_lanes<reg, float>(p);
+#endif
+  }
+  static reg load(const bfloat16* p) {
+    return _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_cvtepu16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p))), 16));
+  }
+  static void store(float* p, reg x) {
+    _mm256_storeu_ps(p, x);
+  }
+  static reg add(reg x, reg y) {
+    return _mm256_add_ps(x, y);
+  }
+  static reg sub(reg x, reg y) {
+    return _mm256_sub_ps(x, y);
+  }
+  static reg mul(reg x, reg y) {
+    return _mm256_mul_ps(x, y);
+  }
+  static reg abs(reg x) {
+    return _mm256_andnot_ps(_mm256_set1_ps(-0.0f), x);
+  }
+  static reg fmadd(reg x, reg y, reg acc) {
+#if defined(__FMA__)
+    return _mm256_fmadd_ps(x, y, acc);
+#else
+    return _mm256_add_ps(_mm256_mul_ps(x, y), acc);
+#endif
+  }
+  static float reduce(reg x) {
+    __m128 sum = _mm_add_ps(_mm256_castps256_ps128(x), _mm256_extractf128_ps(x, 1));
+    sum        = _mm_add_ps(sum, _mm_movehl_ps(sum, sum));
+    return _mm_cvtss_f32(_mm_add_ss(sum, _mm_shuffle_ps(sum, sum, 1)));
+  }
+  static reg gather(const float* base, const std::uint32_t* idx) {
+    return _mm256_mask_i32gather_ps(_mm256_setzero_ps(), base, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(idx)), _mm256_castsi256_ps(_mm256_set1_epi32(-1)), 4);
+  }
+  static void scatter(float* base, const std::uint32_t* idx, reg x) {
+    scatter_lanes(base, idx, x);
+  }
+};
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+template<>
+struct simd<double> {
+  using reg                          = __m128d;
+  static constexpr std::size_t width = 2;
+
+  static reg zero() {
+    return _mm_setzero_pd();
+  }
+  static reg set1(double x) {
+    return _mm_set1_pd(x);
+  }
+  static reg load(const double* p) {
+    return _mm_loadu_pd(p);
+  }
+  /* widening loads read width narrower elements */
+  static reg load(const float* p) {
+    return _mm_cvtps_pd(_mm_castsi128_ps(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(p))));
+  }
+  static void store(double* p, reg x) {
+    _mm_storeu_pd(p, x);
+  }
+  static reg add(reg x, reg y) {
+    return _mm_add_pd(x, y);
+  }
+  static reg sub(reg x, reg y) {
+    return _mm_sub_pd(x, y);
+  }
+  static reg mul(reg x, reg y) {
+    return _mm_mul_pd(x, y);
+  }
+  static reg abs(reg x) {
+    return _mm_andnot_pd(_mm_set1_pd(-0.0), x);
+  }
+  static reg fmadd(reg x, reg y, reg acc) {
+    return _mm_add_pd(_mm_mul_pd(x, y), acc);
+  }
+  static double reduce(reg x) {
+    return _mm_cvtsd_f64(_mm_add_sd(x, _mm_unpackhi_pd(x, x)));
+  }
+  static reg gather(const double* base, const std::uint32_t* idx) {
+    return _mm_set_pd(base[static_cast<std::int32_t>(idx[1])], base[static_cast<std::int32_t>(idx[0])]);
+  }
+  static reg gather(const float* base, const std::uint32_t* idx) {
+    return _mm_set_pd(base[static_cast<std::int32_t>(idx[1])], base[static_cast<std::int32_t>(idx[0])]);
+  }
+  static void scatter(double* base, const std::uint32_t* idx, reg x) {
+    scatter_lanes(base, idx, x);
+  }
+};
+
+template<>
+struct simd<float> {
+  using reg                          = __m128;
+  static constexpr std::size_t width = 4;
+
+  static reg zero() {
+    return _mm_setzero_ps();
+  }
+  static reg set1(float x) {
+    return _mm_set1_ps(x);
+  }
+  static reg load(const float* p) {
+    return _mm_loadu_ps(p);
+  }
+  static reg load(const half* p) {
+#if defined(__F16C__)
+    return _mm_cvtph_ps(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(p)));
+#else
+    return load_lanes<reg, float>(p);
+#endif
+  }
+  static reg load(const bfloat16* p) {
+    return _mm_castsi128_ps(_mm_unpacklo_epi16(_mm_setzero_si128(), _mm_loadl_epi64(reinterpret_cast<const __m128i*>(p))));
+  }
+  static void store(float* p, reg x) {
+    _mm_storeu_ps(p, x);
+  }
+  static reg add(reg x, reg y) {
+    return _mm_add_ps(x, y);
+  }
+  static reg sub(reg x, reg y) {
+    return _mm_sub_ps(x, y);
+  }
+  static reg mul(reg x, reg y) {
+    return _mm_mul_ps(x, y);
+  }
+  static reg abs(reg x) {
+    return _mm_andnot_ps(_mm_set1_ps(-0.0f), x);
+  }
+  static reg fmadd(reg x, reg y, reg acc) {
+    return _mm_add_ps(_mm_mul_ps(x, y), acc);
+  }
+  static float reduce(reg x) {
+    const __m128 sum = _mm_add_ps(x, _mm_movehl_ps(x, x));
+    return _mm_cvtss_f32(_mm_add_ss(sum, _mm_shuffle_ps(sum, sum, 1)));
+  }
+  static reg gather(const float* base, const std::uint32_t* idx) {
+    return _mm_set_ps(base[static_cast<std::int32_t>(idx[3])], base[static_cast<std::int32_t>(idx[2])], base[static_cast<std::int32_t>(idx[1])], base[static_cast<std::int32_t>(idx[0])]);
+  }
+  static void scatter(float* base, const std::uint32_t* idx, reg x) {
+    scatter_lanes(base, idx, x);
+  }
+};
+#endif
+
+template<typename T, typename = void>
+struct has_simd : std::false_type {};
+
+template<typename T>
+struct has_simd<T, std::void_t<decltype(simd<T>::width)>> : std::true_type {};
+
+template<typename T>
+inline constexpr bool has_simd_v = has_simd<T>::value;
+
+/* elements per SIMD register, 1 for types without simd<T> */
+template<typename T, typename = void>
+struct simd_width : std::integral_constant<std::size_t, 1> {};
+
+template<typename T>
+struct simd_width<T, std::void_t<decltype(simd<T>::width)>> : std::integral_constant<std::size_t, simd<T>::width> {};
+
+/* simd<A>::load reads T, widening it when T is narrower than A */
+template<typename A, typename T, typename = void>
+struct has_widening_load : std::false_type {};
+
+template<typename A, typename T>
+struct has_widening_load<A, T, std::void_t<decltype(static_cast<void>(simd<A>::load(std::declval<const T*>())))>> : std::true_type {};
+
+template<typename A, typename T>
+inline constexpr bool has_widening_load_v = has_widening_load<A, T>::value;
+
+/* simd<A>::gather reads T, widening it when T is narrower than A */
+template<typename A, typename T, typename = void>
+struct has_widening_gather : std::false_type {};
+
+template<typename A, typename T>
+struct has_widening_gather<A, T, std::void_t<decltype(static_cast<void>(simd<A>::gather(std::declval<const T*>(), std::declval<const std::uint32_t*>())))>> : std::true_type {};
+
+template<typename A, typename T>
+inline constexpr bool has_widening_gather_v = has_widening_gather<A, T>::value;
+
+/* number of independent accumulators used by the reductions */
+inline constexpr std::size_t accumulators = 4;
+
+/* r[i] = x[i] + y[i]; r may be x or y but must not partially overlap them */
+template<typename T>
+void add(const T* x, const T* y, T* r, std::size_t n) {
+  std::size_t i = 0;
+  if constexpr (has_simd_v<T>) {
+    using s = simd<T>;
+    for (; i + s::width <= n; i += s::width) {
+      s::store(r + i, s::add(s::load(x + i), s::load(y + i)));
+    }
+  }
+  for (; i < n; ++i) {
+    r[i] = x[i] + y[i];
+  }
+}
+
+/* r[i] = x[i] - y[i]; r may be x or y but must not partially overlap them */
+template<typename T>
+void subtract(const T* x, const T* y, T* r, std::size_t n) {
+  std::size_t i = 0;
+  if constexpr (has_simd_v<T>) {
+    using s = simd<T>;
+    for (; i + s::width <= n; i += s::width) {
+      s::store(r + i, s::sub(s::load(x + i), s::load(y + i)));
+    }
+  }
+  for (; i < n; ++i) {
+    r[i] = x[i] - y[i];
+  }
+}
+
+/* r[i] = x[i] * a; r may be x but must not partially overlap it */
+template<typename T>
+void scale(const T* x, T a, T* r, std::size_t n) {
+  std::size_t i = 0;
+  if constexpr (has_simd_v<T>) {
+    using s       = simd<T>;
+    const auto va = s::set1(a);
+    for (; i + s::width <= n; i += s::width) {
+      s::store(r + i, s::mul(s::load(x + i), va));
+    }
+  }
+  for (; i < n; ++i) {
+    r[i] = x[i] * a;
+  }
+}
+
+/* y[i] += a * x[i]; x and y must not partially overlap */
+template<typename T>
+void axpy(T a, const T* x, T* y, std::size_t n) {
+  std::size_t i = 0;
+  if constexpr (has_simd_v<T>) {
+    using s       = simd<T>;
+    const auto va = s::set1(a);
+    for (; i + s::width <= n; i += s::width) {
+      s::store(y + i, s::fmadd(va, s::load(x + i), s::load(y + i)));
+    }
+  }
+  for (; i < n; ++i) {
+    y[i] += a * x[i];
+  }
+}
+
+/* y[i] = a * x[i] + b * y[i]; x and y must not partially overlap */
+template<typename T>
+void axpby(T a, const T* x, T b, T* y, std::size_t n) {
+  std::size_t i = 0;
+  if constexpr (has_simd_v<T>) {
+    using s       = simd<T>;
+    const auto va = s::set1(a);
+    const auto vb = s::set1(b);
+    for (; i + s::width <= n; i += s::width) {
+      s::store(y + i, s::fmadd(va, s::load(x + i), s::mul(vb, s::load(y + i))));
+    }
+  }
+  for (; i < n; ++i) {
+    y[i] = a * x[i] + b * y[i];
+  }
+}
+
+/* sum of x[i] * y[i] without conjugation, accumulated in A */
+template<typename T, typename A = T>
+A dot(const T* x, const T* y, std::size_t n) {
+  std::size_t i = 0;
+  A ret         = A();
+  if constexpr (has_widening_load_v<A, T>) {
+    using s                     = simd<A>;
+    constexpr std::size_t block = accumulators * s::width;
+
+    auto acc0 = s::zero();
+    auto acc1 = s::zero();
+    auto acc2 = s::zero();
+    auto acc3 = s::zero();
+    for (; i + block <= n; i += block) {
+      acc0 = s::fmadd(s::load(x + i), s::load(y + i), acc0);
+      acc1 = s::fmadd(s::load(x + i + s::width), s::load(y + i + s::width), acc1);
+      acc2 = s::fmadd(s::load(x + i + 2 * s::width), s::load(y + i + 2 * s::width), acc2);
+      acc3 = s::fmadd(s::load(x + i + 3 * s::width), s::load(y + i + 3 * s::width), acc3);
+    }
+    for (; i + s::width <= n; i += s::width) {
+      acc0 = s::fmadd(s::load(x + i), s::load(y + i), acc0);
+    }
+    ret = s::reduce(s::add(s::add(acc0, acc1), s::add(acc2, acc3)));
+  } else {
+    A acc[accumulators] = {};
+    for (; i + accumulators <= n; i += accumulators) {
+      for (std::size_t k = 0; k < accumulators; ++k) {
+        acc[k] += static_cast<A>(x[i + k]) * static_cast<A>(y[i + k]);
+      }
+    }
+    ret = (acc[0] + acc[1]) + (acc[2] + acc[3]);
+  }
+  for (; i < n; ++i) {
+    ret += static_cast<A>(x[i]) * static_cast<A>(y[i]);
+  }
+  return ret;
+}
+
+/* sum of |x[i]|, accumulated in A */
+template<typename T, typename A = T>
+A sum_abs(const T* x, std::size_t n) {
+  using std::abs;
+  std::size_t i = 0;
+  A ret         = A();
+  if constexpr (has_widening_load_v<A, T>) {
+    using s                     = simd<A>;
+    constexpr std::size_t block = accumulators * s::width;
+
+    auto acc0 = s::zero();
+    auto acc1 = s::zero();
+    auto acc2 = s::zero();
+    auto acc3 = s::zero();
+    for (; i + block <= n; i += block) {
+      acc0 = s::add(s::abs(s::load(x + i)), acc0);
+      acc1 = s::add(s::abs(s::load(x + i + s::width)), acc1);
+      acc2 = s::add(s::abs(s::load(x + i + 2 * s::width)), acc2);
+      acc3 = s::add(s::abs(s::load(x + i + 3 * s::width)), acc3);
+    }
+    for (; i + s::width <= n; i += s::width) {
+      acc0 = s::add(s::abs(s::load(x + i)), acc0);
+    }
+    ret = s::reduce(s::add(s::add(acc0, acc1), s::add(acc2, acc3)));
+  } else {
+    A acc[accumulators] = {};
+    for (; i + accumulators <= n; i += accumulators) {
+      for (std::size_t k = 0; k < accumulators; ++k) {
+        acc[k] += abs(static_cast<A>(x[i + k]));
+      }
+    }
+    ret = (acc[0] + acc[1]) + (acc[2] + acc[3]);
+  }
+  for (; i < n; ++i) {
+    ret += abs(static_cast<A>(x[i]));
+  }
+  return ret;
+}
+
+/*
+ * Split complex dot: (re, im) = sum of x[i] * conj(y[i]) accumulated in A,
+ * where each complex vector is given as separate real and imaginary arrays.
+ */
+template<typename T, typename A = T>
+void complex_dot(const T* xr, const T* xi, const T* yr, const T* yi, std::size_t n, A& re, A& im) {
+  std::size_t i = 0;
+  A rr          = A();
+  A ii          = A();
+  A ir          = A();
+  A ri          = A();
+  if constexpr (has_widening_load_v<A, T>) {
+    using s = simd<A>;
+
+    auto acc_rr = s::zero();
+    auto acc_ii = s::zero();
+    auto acc_ir = s::zero();
+    auto acc_ri = s::zero();
+    for (; i + s::width <= n; i += s::width) {
+      const auto a = s::load(xr + i);
+      const auto b = s::load(xi + i);
+      const auto c = s::load(yr + i);
+      const auto d = s::load(yi + i);
+      acc_rr       = s::fmadd(a, c, acc_rr);
+      acc_ii       = s::fmadd(b, d, acc_ii);
+      acc_ir       = s::fmadd(b, c, acc_ir);
+      acc_ri       = s::fmadd(a, d, acc_ri);
+    }
+    rr = s::reduce(acc_rr);
+    ii = s::reduce(acc_ii);
+    ir = s::reduce(acc_ir);
+    ri = s::reduce(acc_ri);
+  }
+  for (; i < n; ++i) {
+    rr += static_cast<A>(xr[i]) * static_cast<A>(yr[i]);
+    ii += static_cast<A>(xi[i]) * static_cast<A>(yi[i]);
+    ir += static_cast<A>(xi[i]) * static_cast<A>(yr[i]);
+    ri += static_cast<A>(xr[i]) * static_cast<A>(yi[i]);
+  }
+  re = rr + ii;
+  im = ir - ri;
+}
+
+/* y += (ar + i ai) * x on split complex arrays; x and y must not partially overlap */
+template<typename T>
+void complex_axpy(T ar, T ai, const T* xr, const T* xi, T* yr, T* yi, std::size_t n) {
+  std::size_t i = 0;
+  if constexpr (has_simd_v<T>) {
+    using s        = simd<T>;
+    const auto var = s::set1(ar);
+    const auto vai = s::set1(ai);
+    const auto vni = s::set1(-ai);
+    for (; i + s::width <= n; i += s::width) {
+      const auto a = s::load(xr + i);
+      const auto b = s::load(xi + i);
+      s::store(yr + i, s::fmadd(vni, b, s::fmadd(var, a, s::load(yr + i))));
+      s::store(yi + i, s::fmadd(vai, a, s::fmadd(var, b, s::load(yi + i))));
+    }
+  }
+  for (; i < n; ++i) {
+    const T a = xr[i];
+    const T b = xi[i];
+    yr[i] += ar * a - ai * b;
+    yi[i] += ar * b + ai * a;
+  }
+}
+
+/* r = (ar + i ai) * x on split complex arrays; r may be x but must not partially overlap it */
+template<typename T>
+void complex_scale(T ar, T ai, const T* xr, const T* xi, T* rr, T* ri, std::size_t n) {
+  std::size_t i = 0;
+  if constexpr (has_simd_v<T>) {
+    using s        = simd<T>;
+    const auto var = s::set1(ar);
+    const auto vai = s::set1(ai);
+    for (; i + s::width <= n; i += s::width) {
+      const auto a = s::load(xr + i);
+      const auto b = s::load(xi + i);
+      s::store(rr + i, s::sub(s::mul(a, var), s::mul(b, vai)));
+      s::store(ri + i, s::fmadd(b, var, s::mul(a, vai)));
+    }
+  }
+  for (; i < n; ++i) {
+    const T a = xr[i];
+    const T b = xi[i];
+    rr[i]     = a * ar - b * ai;
+    ri[i]     = a * ai + b * ar;
+  }
+}
+
+/* sum of x[k] * y[idx[k]] in A, every idx[k] below 2^31 */
+template<typename T, typename A = T>
+A gather_dot(const T* x, const std::uint32_t* idx, const T* y, std::size_t n) {
+  std::size_t i = 0;
+  A ret         = A();
+  if constexpr (has_widening_load_v<A, T> && has_widening_gather_v<A, T>) {
+    using s                     = simd<A>;
+    constexpr std::size_t block = 2 * s::width;
+
+    /* gathers have long latency, two independent chains are enough to cover it */
+    auto acc0 = s::zero();
+    auto acc1 = s::zero();
+    for (; i + block <= n; i += block) {
+      acc0 = s::fmadd(s::load(x + i), s::gather(y, idx + i), acc0);
+      acc1 = s::fmadd(s::load(x + i + s::width), s::gather(y, idx + i + s::width), acc1);
+    }
+    for (; i + s::width <= n; i += s::width) {
+      acc0 = s::fmadd(s::load(x + i), s::gather(y, idx + i), acc0);
+    }
+    ret = s::reduce(s::add(acc0, acc1));
+  }
+  for (; i < n; ++i) {
+    ret += static_cast<A>(x[i]) * static_cast<A>(y[idx[i]]);
+  }
+  return ret;
+}
+
+/* y[idx[k]] += a * x[k], idx strictly increasing and below 2^31 */
+template<typename T>
+void scatter_axpy(T a, const T* x, const std::uint32_t* idx, T* y, std::size_t n) {
+  std::size_t i = 0;
+  if constexpr (has_simd_v<T>) {
+    using s       = simd<T>;
+    const auto va = s::set1(a);
+    for (; i + s::width <= n; i += s::width) {
+      s::scatter(y, idx + i, s::fmadd(va, s::load(x + i), s::gather(y, idx + i)));
+    }
+  }
+  for (; i < n; ++i) {
+    y[idx[i]] += a * x[i];
+  }
+}
+/*
+ * Strided kernels for views with step != 1, such as matrix columns.
+ *
+ * gather_strided and scatter_strided move elements between a strided view
+ * and a contiguous buffer, with hardware gather and scatter where simd<T>
+ * has them. Hardware prefetchers follow short strides, but not ones of
+ * prefetch_min_stride bytes or more, which cross a page every element or
+ * two; those are prefetched in software prefetch_distance elements ahead.
+ * The other kernels stage blocks of staging_block<T> elements through stack
+ * buffers of about staging_bytes each and run the contiguous kernels on
+ * them, so element types of any size keep the stack use bounded.
+ */
+inline constexpr std::size_t prefetch_min_stride = 2048;
+inline constexpr std::size_t prefetch_distance   = 16;
+inline constexpr std::size_t staging_bytes       = 2048;
+
+template<typename T>
+inline constexpr std::size_t staging_block = sizeof(T) < staging_bytes ? staging_bytes / sizeof(T) : 1;
+
+inline void prefetch(const void* p) noexcept {
+#if defined(__GNUC__)
+  __builtin_prefetch(p);
+#elif defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+  _mm_prefetch(static_cast<const char*>(p), _MM_HINT_T0);
+#else
+  static_cast<void>(p);
+#endif
+}
+
+/* address of element i of the view starting at x with the given step */
+template<typename T>
+T* strided_at(T* x, std::ptrdiff_t step, std::size_t i) noexcept {
+  return x + static_cast<std::ptrdiff_t>(i) * step;
+}
+
+template<typename T>
+bool needs_prefetch(std::ptrdiff_t step) noexcept {
+  return static_cast<std::size_t>(step < 0 ? -step : step) * sizeof(T) >= prefetch_min_stride;
+}
+
+/* offsets k * step for one register, or false if the last one does not fit the 32-bit gather index */
+template<std::size_t width>
+bool strided_offsets(std::ptrdiff_t step, std::uint32_t (&off)[width]) noexcept {
+  const std::ptrdiff_t limit = std::numeric_limits<std::int32_t>::max() / static_cast<std::ptrdiff_t>(width);
+  if (step > limit || step < -limit) {
+    return false;
+  }
+  for (std::size_t k = 0; k < width; ++k) {
+    off[k] = static_cast<std::uint32_t>(static_cast<std::int32_t>(static_cast<std::ptrdiff_t>(k) * step));
+  }
+  return true;
+}
+
+/* out[k] = x[k * step] for k in [0, n); out must not overlap the elements of x */
+template<typename T>
+void gather_strided(const T* x, std::ptrdiff_t step, T* out, std::size_t n) {
+  const bool far = needs_prefetch<T>(step);
+  std::size_t i  = 0;
+  if constexpr (has_simd_v<T>) {
+    using s = simd<T>;
+    std::uint32_t off[s::width];
+    if (strided_offsets(step, off)) {
+      for (; i + s::width <= n; i += s::width) {
+        if (far) {
+          for (std::size_t k = i + prefetch_distance; k < std::min(i + prefetch_distance + s::width, n); ++k) {
+            prefetch(strided_at(x, step, k));
+          }
+        }
+        s::store(out + i, s::gather(strided_at(x, step, i), off));
+      }
+    }
+  }
+  for (; i < n; ++i) {
+    if (far && i + prefetch_distance < n) {
+      prefetch(strided_at(x, step, i + prefetch_distance));
+    }
+    out[i] = *strided_at(x, step, i);
+  }
+}
+
+/* x[k * step] = in[k] for k in [0, n); in must not overlap the elements of x */
+template<typename T>
+void scatter_strided(const T* in, T* x, std::ptrdiff_t step, std::size_t n) {
+  const bool far = needs_prefetch<T>(step);
+  std::size_t i  = 0;
+  if constexpr (has_simd_v<T>) {
+    using s = simd<T>;
+    std::uint32_t off[s::width];
+    if (strided_offsets(step, off)) {
+      for (; i + s::width <= n; i += s::width) {
+        if (far) {
+          for (std::size_t k = i + prefetch_distance; k < std::min(i + prefetch_distance + s::width, n); ++k) {
+            prefetch(strided_at(x, step, k));
+          }
+        }
+        s::scatter(strided_at(x, step, i), off, s::load(in + i));
+      }
+    }
+  }
+  for (; i < n; ++i) {
+    if (far && i + prefetch_distance < n) {
+      prefetch(strided_at(x, step, i + prefetch_distance));
+    }
+    *strided_at(x, step, i) = in[i];
+  }
+}
+
+/* elements [i, i + n) of a strided view as a contiguous array: in place when step == 1, otherwise gathered into buf */
+template<typename T>
+const T* stage(const T* x, std::ptrdiff_t step, std::size_t i, std::size_t n, T* buf) {
+  if (step == 1) {
+    return x + i;
+  }
+  gather_strided(strided_at(x, step, i), step, buf, n);
+  return buf;
+}
+
+/* f(px, py, pr, n) computes one staged block; r may be x or y but must not partially overlap them */
+template<typename T, typename F>
+void staged_binary(const T* x, std::ptrdiff_t xstep, const T* y, std::ptrdiff_t ystep, T* r, std::ptrdiff_t rstep, std::size_t n, F f) {
+  T xbuf[staging_block<T>];
+  T ybuf[staging_block<T>];
+  for (std::size_t i = 0; i < n; i += staging_block<T>) {
+    const std::size_t m = std::min(staging_block<T>, n - i);
+    const T* px         = stage(x, xstep, i, m, xbuf);
+    const T* py         = stage(y, ystep, i, m, ybuf);
+    if (rstep == 1) {
+      f(px, py, r + i, m);
+    } else {
+      f(px, py, xbuf, m);
+      scatter_strided(xbuf, strided_at(r, rstep, i), rstep, m);
+    }
+  }
+}
+
+/* f(px, pr, n) computes one staged block; r may be x but must not partially overlap it */
+template<typename T, typename F>
+void staged_unary(const T* x, std::ptrdiff_t xstep, T* r, std::ptrdiff_t rstep, std::size_t n, F f) {
+  T xbuf[staging_block<T>];
+  for (std::size_t i = 0; i < n; i += staging_block<T>) {
+    const std::size_t m = std::min(staging_block<T>, n - i);
+    const T* px         = stage(x, xstep, i, m, xbuf);
+    if (rstep == 1) {
+      f(px, r + i, m);
+    } else {
+      f(px, xbuf, m);
+      scatter_strided(xbuf, strided_at(r, rstep, i), rstep, m);
+    }
+  }
+}
+
+/* r[k * rstep] = x[k * xstep]; r may be x but must not partially overlap it */
+template<typename T>
+void strided_copy(const T* x, std::ptrdiff_t xstep, T* r, std::ptrdiff_t rstep, std::size_t n) {
+  if (rstep == 1) {
+    gather_strided(x, xstep, r, n);
+  } else if (xstep == 1) {
+    scatter_strided(x, r, rstep, n);
+  } else {
+    staged_unary(x, xstep, r, rstep, n, [](const T* px, T* pr, std::size_t m) { std::copy(px, px + m, pr); });
+  }
+}
+
+/* r[k * rstep] = x[k * xstep] + y[k * ystep] */
+template<typename T>
+void strided_add(const T* x, std::ptrdiff_t xstep, const T* y, std::ptrdiff_t ystep, T* r, std::ptrdiff_t rstep, std::size_t n) {
+  staged_binary(x, xstep, y, ystep, r, rstep, n, [](const T* px, const T* py, T* pr, std::size_t m) { add(px, py, pr, m); });
+}
+
+/* r[k * rstep] = x[k * xstep] - y[k * ystep] */
+template<typename T>
+void strided_subtract(const T* x, std::ptrdiff_t xstep, const T* y, std::ptrdiff_t ystep, T* r, std::ptrdiff_t rstep, std::size_t n) {
+  staged_binary(x, xstep, y, ystep, r, rstep, n, [](const T* px, const T* py, T* pr, std::size_t m) { subtract(px, py, pr, m); });
+}
+
+/* r[k * rstep] = x[k * xstep] * a */
+template<typename T>
+void strided_scale(const T* x, std::ptrdiff_t xstep, T a, T* r, std::ptrdiff_t rstep, std::size_t n) {
+  staged_unary(x, xstep, r, rstep, n, [a](const T* px, T* pr, std::size_t m) { scale(px, a, pr, m); });
+}
+
+/* sum of x[k * xstep] * y[k * ystep] in A; a block is staged once when x and y are the same view */
+template<typename T, typename A = T>
+A strided_dot(const T* x, std::ptrdiff_t xstep, const T* y, std::ptrdiff_t ystep, std::size_t n) {
+  const bool same = x == y && xstep == ystep;
+  T xbuf[staging_block<T>];
+  T ybuf[staging_block<T>];
+  A ret = A();
+  for (std::size_t i = 0; i < n; i += staging_block<T>) {
+    const std::size_t m = std::min(staging_block<T>, n - i);
+    const T* px         = stage(x, xstep, i, m, xbuf);
+    const T* py         = same ? px : stage(y, ystep, i, m, ybuf);
+    ret += dot<T, A>(px, py, m);
+  }
+  return ret;
+}
+
+/* sum of |x[k * step]| in A */
+template<typename T, typename A = T>
+A strided_sum_abs(const T* x, std::ptrdiff_t step, std::size_t n) {
+  T buf[staging_block<T>];
+  A ret = A();
+  for (std::size_t i = 0; i < n; i += staging_block<T>) {
+    const std::size_t m = std::min(staging_block<T>, n - i);
+    ret += sum_abs<T, A>(stage(x, step, i, m, buf), m);
+  }
+  return ret;
+}
+}  // namespace dicek::math::linalg::detail
+
+#endif /* UUID_EC915F6F_218C_444C_8A6F_FD09D00625A9 */
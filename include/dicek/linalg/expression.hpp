@@ -0,0 +1,219 @@
+/*
+MIT License
+
+Copyright (c) 2022 Daisuke NAGAO
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#ifndef UUID_EF71F2BC_7415_4B2C_B7E7_94437A1E11F8
+#define UUID_EF71F2BC_7415_4B2C_B7E7_94437A1E11F8
+
+#include <cstddef>
+#include <functional>
+#include <memory_resource>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+namespace dicek::math::linalg {
+/*
+ * Lazy element-wise expressions over linalg::vector.
+ *
+ * An expression only records its operands; nothing is computed until it is
+ * assigned to a vector, at which point every element is evaluated in a single
+ * loop directly into the destination. Operands are held by reference, so an
+ * expression must be evaluated before the vectors it refers to go away.
+ */
+template<typename E>
+class vector_expression {
+ public:
+  const E& self() const noexcept {
+    return static_cast<const E&>(*this);
+  }
+
+  std::size_t size() const {
+    return self().size();
+  }
+
+  auto operator[](std::size_t idx) const {
+    return self()[idx];
+  }
+
+ protected:
+  vector_expression() = default;
+};
+
+template<typename V>
+class vector_reference : public vector_expression<vector_reference<V>> {
+ public:
+  using vector_type = V;
+  using scalar_type = typename V::scalar_type;
+
+  explicit vector_reference(const V& v) noexcept : v_(&v) {}
+
+  std::size_t size() const {
+    return v_->size();
+  }
+
+  scalar_type operator[](std::size_t idx) const {
+    return (*v_)[idx];
+  }
+
+  std::pmr::memory_resource* get_allocator() const noexcept {
+    return v_->get_allocator();
+  }
+
+  bool aliases(const V& dst) const noexcept {
+    return dst.may_share_storage_with(*v_) && !dst.has_identical_element_mapping(*v_);
+  }
+
+ private:
+  const V* v_;
+};
+
+template<typename L, typename R, typename Op>
+class vector_binary_expression : public vector_expression<vector_binary_expression<L, R, Op>> {
+ public:
+  using vector_type = typename L::vector_type;
+  using scalar_type = typename L::scalar_type;
+
+  static_assert(std::is_same_v<vector_type, typename R::vector_type>, "operands of a vector expression must have the same vector type");
+
+  vector_binary_expression(const L& lhs, const R& rhs, const char* name) : lhs_(lhs), rhs_(rhs) {
+    if (lhs_.size() != rhs_.size()) {
+      throw std::invalid_argument(std::string(name) + ": size mismatch");
+    }
+  }
+
+  std::size_t size() const {
+    return lhs_.size();
+  }
+
+  scalar_type operator[](std::size_t idx) const {
+    return Op{}(lhs_[idx], rhs_[idx]);
+  }
+
+  std::pmr::memory_resource* get_allocator() const noexcept {
+    return lhs_.get_allocator();
+  }
+
+  bool aliases(const vector_type& dst) const noexcept {
+    return lhs_.aliases(dst) || rhs_.aliases(dst);
+  }
+
+ private:
+  L lhs_;
+  R rhs_;
+};
+
+template<typename E, typename Op>
+class vector_scalar_expression : public vector_expression<vector_scalar_expression<E, Op>> {
+ public:
+  using vector_type = typename E::vector_type;
+  using scalar_type = typename E::scalar_type;
+
+  vector_scalar_expression(const E& e, scalar_type val) : e_(e), val_(val) {}
+
+  std::size_t size() const {
+    return e_.size();
+  }
+
+  scalar_type operator[](std::size_t idx) const {
+    return Op{}(e_[idx], val_);
+  }
+
+  std::pmr::memory_resource* get_allocator() const noexcept {
+    return e_.get_allocator();
+  }
+
+  bool aliases(const vector_type& dst) const noexcept {
+    return e_.aliases(dst);
+  }
+
+ private:
+  E e_;
+  scalar_type val_;
+};
+
+template<typename E, typename F>
+class vector_unary_expression : public vector_expression<vector_unary_expression<E, F>> {
+ public:
+  using vector_type = typename E::vector_type;
+  using scalar_type = typename E::scalar_type;
+
+  vector_unary_expression(const E& e, F f) : e_(e), f_(f) {}
+
+  std::size_t size() const {
+    return e_.size();
+  }
+
+  scalar_type operator[](std::size_t idx) const {
+    return f_(e_[idx]);
+  }
+
+  std::pmr::memory_resource* get_allocator() const noexcept {
+    return e_.get_allocator();
+  }
+
+  bool aliases(const vector_type& dst) const noexcept {
+    return e_.aliases(dst);
+  }
+
+ private:
+  E e_;
+  F f_;
+};
+
+template<typename L, typename R>
+vector_binary_expression<L, R, std::plus<>> operator+(const vector_expression<L>& lhs, const vector_expression<R>& rhs) {
+  return vector_binary_expression<L, R, std::plus<>>(lhs.self(), rhs.self(), "vector_expression::operator+");
+}
+
+template<typename L, typename R>
+vector_binary_expression<L, R, std::minus<>> operator-(const vector_expression<L>& lhs, const vector_expression<R>& rhs) {
+  return vector_binary_expression<L, R, std::minus<>>(lhs.self(), rhs.self(), "vector_expression::operator-");
+}
+
+template<typename E>
+vector_scalar_expression<E, std::multiplies<>> operator*(const vector_expression<E>& lhs, typename E::scalar_type rhs) {
+  return vector_scalar_expression<E, std::multiplies<>>(lhs.self(), rhs);
+}
+
+template<typename E>
+vector_scalar_expression<E, std::multiplies<>> operator*(typename E::scalar_type lhs, const vector_expression<E>& rhs) {
+  return vector_scalar_expression<E, std::multiplies<>>(rhs.self(), lhs);
+}
+
+template<typename E>
+vector_scalar_expression<E, std::divides<>> operator/(const vector_expression<E>& lhs, typename E::scalar_type rhs) {
+  return vector_scalar_expression<E, std::divides<>>(lhs.self(), rhs);
+}
+
+template<typename E>
+vector_unary_expression<E, std::negate<>> operator-(const vector_expression<E>& e) {
+  return vector_unary_expression<E, std::negate<>>(e.self(), std::negate<>{});
+}
+
+template<typename E, typename F>
+vector_unary_expression<E, F> map(const vector_expression<E>& e, F f) {
+  return vector_unary_expression<E, F>(e.self(), f);
+}
+}  // namespace dicek::math::linalg
+
+#endif /* UUID_EF71F2BC_7415_4B2C_B7E7_94437A1E11F8 */
@@ -0,0 +1,306 @@
+/*
+MIT License
+
+Copyright (c) 2022 Daisuke NAGAO
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#ifndef UUID_E62EC40E_FB04_4AD9_90D6_9241E2BA49D9
+#define UUID_E62EC40E_FB04_4AD9_90D6_9241E2BA49D9
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <dicek/linalg/vector.hpp>
+#include <dicek/scalar_traits.hpp>
+#include <functional>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace dicek::math::linalg {
+namespace detail {
+/* power-of-two packs of up to 32 bytes (float4, double4, ...) are aligned to their size, so one SIMD load fetches them */
+template<typename T, std::size_t N>
+constexpr std::size_t packed_alignment() noexcept {
+  if (std::is_arithmetic_v<T> && N > 1 && (N & (N - 1)) == 0 && sizeof(T) * N <= 32) {
+    return sizeof(T) * N;
+  }
+  return alignof(T);
+}
+}  // namespace detail
+
+/*
+ * Vector of N elements stored inline, with constexpr arithmetic.
+ *
+ * Every element-wise operation and reduction expands to a fold over the N
+ * indices, so there is no loop left for small N. An array of fixed_vectors is
+ * laid out without padding, and as_vector / component_view expose it to the
+ * dynamic vector's free functions without copying.
+ *
+ * There are no hand-written SIMD kernels here: intrinsics cannot be used in
+ * constexpr functions in C++17. Packs such as float4 and double4 are only
+ * aligned to their size, which lets the compiler load each one with a
+ * single SIMD instruction and vectorize the unrolled folds. Whether it does
+ * so depends on the compiler and flags.
+ */
+template<typename T, std::size_t N, typename scalar_traits = dicek::math::scalar_traits<T>>
+class alignas(detail::packed_alignment<typename scalar_traits::scalar_type, N>()) fixed_vector {
+ public:
+  using scalar_traits_type = scalar_traits;
+  using scalar_type        = typename scalar_traits::scalar_type;
+
+  static_assert(N > 0, "fixed_vector: N must be positive");
+
+  /* value-initializes every element */
+  constexpr fixed_vector() : elm_{} {}
+
+  template<typename... Args, typename = std::enable_if_t<sizeof...(Args) == N && (std::is_convertible_v<Args, scalar_type> && ...)>>
+  constexpr fixed_vector(Args... args) : elm_{static_cast<scalar_type>(args)...} {}
+
+  explicit constexpr fixed_vector(const std::array<scalar_type, N>& elm) : elm_(elm) {}
+
+  static constexpr std::size_t size() noexcept {
+    return N;
+  }
+
+  constexpr const scalar_type& operator[](std::size_t idx) const {
+    return elm_[idx];
+  }
+  constexpr scalar_type& operator[](std::size_t idx) {
+    return elm_[idx];
+  }
+
+  constexpr const scalar_type& at(std::size_t idx) const {
+    if (idx >= N) {
+      throw std::out_of_range("fixed_vector::at: idx >= this->size()");
+    }
+    return elm_[idx];
+  }
+  constexpr scalar_type& at(std::size_t idx) {
+    if (idx >= N) {
+      throw std::out_of_range("fixed_vector::at: idx >= this->size()");
+    }
+    return elm_[idx];
+  }
+
+  constexpr const scalar_type* data() const noexcept {
+    return elm_.data();
+  }
+  constexpr scalar_type* data() noexcept {
+    return elm_.data();
+  }
+
+  constexpr const scalar_type* begin() const noexcept {
+    return elm_.data();
+  }
+  constexpr scalar_type* begin() noexcept {
+    return elm_.data();
+  }
+  constexpr const scalar_type* end() const noexcept {
+    return elm_.data() + N;
+  }
+  constexpr scalar_type* end() noexcept {
+    return elm_.data() + N;
+  }
+
+  template<typename F>
+  constexpr fixed_vector map(F f) const {
+    return map_impl(f, std::make_index_sequence<N>{});
+  }
+
+  constexpr fixed_vector operator+(const fixed_vector& rhs) const {
+    return zip_impl(rhs, std::plus<>{}, std::make_index_sequence<N>{});
+  }
+
+  constexpr fixed_vector operator-(const fixed_vector& rhs) const {
+    return zip_impl(rhs, std::minus<>{}, std::make_index_sequence<N>{});
+  }
+
+  constexpr fixed_vector operator-() const {
+    return map(std::negate<>{});
+  }
+
+  constexpr fixed_vector operator*(scalar_type val) const {
+    return map([val](scalar_type x) { return x * val; });
+  }
+
+  constexpr fixed_vector operator/(scalar_type val) const {
+    return map([val](scalar_type x) { return x / val; });
+  }
+
+  friend constexpr fixed_vector operator*(scalar_type lhs, const fixed_vector& rhs) {
+    return rhs * lhs;
+  }
+
+  constexpr fixed_vector& operator+=(const fixed_vector& rhs) {
+    return *this = *this + rhs;
+  }
+
+  constexpr fixed_vector& operator-=(const fixed_vector& rhs) {
+    return *this = *this - rhs;
+  }
+
+  constexpr fixed_vector& operator*=(scalar_type val) {
+    return *this = *this * val;
+  }
+
+  constexpr fixed_vector& operator/=(scalar_type val) {
+    return *this = *this / val;
+  }
+
+  constexpr bool operator==(const fixed_vector& rhs) const {
+    return equal_impl(rhs, std::make_index_sequence<N>{});
+  }
+
+  constexpr bool operator!=(const fixed_vector& rhs) const {
+    return !(*this == rhs);
+  }
+
+ private:
+  template<typename F, std::size_t... I>
+  constexpr fixed_vector map_impl(F f, std::index_sequence<I...>) const {
+    return fixed_vector(f(elm_[I])...);
+  }
+
+  template<typename F, std::size_t... I>
+  constexpr fixed_vector zip_impl(const fixed_vector& rhs, F f, std::index_sequence<I...>) const {
+    return fixed_vector(f(elm_[I], rhs.elm_[I])...);
+  }
+
+  template<std::size_t... I>
+  constexpr bool equal_impl(const fixed_vector& rhs, std::index_sequence<I...>) const {
+    return ((elm_[I] == rhs.elm_[I]) && ...);
+  }
+
+  std::array<scalar_type, N> elm_;
+};
+
+using float2  = fixed_vector<float, 2>;
+using float3  = fixed_vector<float, 3>;
+using float4  = fixed_vector<float, 4>;
+using double2 = fixed_vector<double, 2>;
+using double3 = fixed_vector<double, 3>;
+using double4 = fixed_vector<double, 4>;
+
+static_assert(sizeof(float4) == 4 * sizeof(float) && alignof(float4) == sizeof(float4), "float4 must be packed and aligned to its size");
+static_assert(sizeof(double4) == 4 * sizeof(double) && alignof(double4) == sizeof(double4), "double4 must be packed and aligned to its size");
+
+namespace detail {
+template<typename T, std::size_t N, typename scalar_traits, std::size_t... I>
+constexpr auto dot_impl(const fixed_vector<T, N, scalar_traits>& lhs, const fixed_vector<T, N, scalar_traits>& rhs, std::index_sequence<I...>) {
+  return (... + (lhs[I] * scalar_traits::conj(rhs[I])));
+}
+
+template<typename T, std::size_t N, typename scalar_traits, std::size_t... I>
+auto norm1_impl(const fixed_vector<T, N, scalar_traits>& v, std::index_sequence<I...>) {
+  return (... + scalar_traits::abs(v[I]));
+}
+}  // namespace detail
+
+/* sum of lhs[i] * conj(rhs[i]), as for the dynamic vector */
+template<typename T, std::size_t N, typename scalar_traits>
+constexpr typename fixed_vector<T, N, scalar_traits>::scalar_type dot(const fixed_vector<T, N, scalar_traits>& lhs, const fixed_vector<T, N, scalar_traits>& rhs) {
+  return detail::dot_impl(lhs, rhs, std::make_index_sequence<N>{});
+}
+
+template<typename T, std::size_t N, typename scalar_traits>
+constexpr typename fixed_vector<T, N, scalar_traits>::scalar_type inner_product(const fixed_vector<T, N, scalar_traits>& lhs, const fixed_vector<T, N, scalar_traits>& rhs) {
+  return dot(lhs, rhs);
+}
+
+template<typename T, typename scalar_traits>
+constexpr fixed_vector<T, 3, scalar_traits> cross(const fixed_vector<T, 3, scalar_traits>& lhs, const fixed_vector<T, 3, scalar_traits>& rhs) {
+  return fixed_vector<T, 3, scalar_traits>(lhs[1] * rhs[2] - lhs[2] * rhs[1], lhs[2] * rhs[0] - lhs[0] * rhs[2], lhs[0] * rhs[1] - lhs[1] * rhs[0]);
+}
+
+template<typename T, std::size_t N, typename scalar_traits>
+auto norm1(const fixed_vector<T, N, scalar_traits>& v) {
+  return detail::norm1_impl(v, std::make_index_sequence<N>{});
+}
+
+/* max of |v[i]|; NaN if any element is NaN */
+template<typename T, std::size_t N, typename scalar_traits>
+auto norm_inf(const fixed_vector<T, N, scalar_traits>& v) {
+  auto ret = scalar_traits::abs(v[0]);
+  for (std::size_t i = 1; i < N; ++i) {
+    const auto a = scalar_traits::abs(v[i]);
+    if (a > ret || a != a) {
+      ret = a;
+    }
+  }
+  return ret;
+}
+
+/* Euclidean norm; rescales by norm_inf only when the direct sum of squares overflowed or underflowed */
+template<typename T, std::size_t N, typename scalar_traits>
+auto norm2(const fixed_vector<T, N, scalar_traits>& v) {
+  using std::sqrt;
+  using real_type = decltype(scalar_traits::abs(v[0]));
+
+  const real_type ssq = std::real(dot(v, v));
+  if constexpr (std::numeric_limits<real_type>::is_iec559) {
+    constexpr real_type smallest_exact = std::numeric_limits<real_type>::min() / std::numeric_limits<real_type>::epsilon();
+    if (!(std::isfinite(ssq) && ssq >= smallest_exact)) {
+      const real_type scale = norm_inf(v);
+      if (scale == real_type(0) || !std::isfinite(scale)) {
+        return scale;
+      }
+      return scale * sqrt(std::real(dot(v / scale, v / scale)));
+    }
+  }
+  return sqrt(ssq);
+}
+
+/* non-owning dynamic view of v's elements */
+template<typename T, std::size_t N, typename scalar_traits>
+vector<T, scalar_traits> as_vector(fixed_vector<T, N, scalar_traits>& v) {
+  return vector<T, scalar_traits>(v.data(), N);
+}
+
+/* vector has no read-only view: this one refers to v's elements and must not be written through */
+template<typename T, std::size_t N, typename scalar_traits>
+vector<T, scalar_traits> as_vector(const fixed_vector<T, N, scalar_traits>& v) {
+  return vector<T, scalar_traits>(const_cast<typename fixed_vector<T, N, scalar_traits>::scalar_type*>(v.data()), N);
+}
+
+/* non-owning strided view of component k of count consecutive fixed_vectors, e.g. all x coordinates */
+template<typename T, std::size_t N, typename scalar_traits>
+vector<T, scalar_traits> component_view(fixed_vector<T, N, scalar_traits>* first, std::size_t count, std::size_t k) {
+  using scalar_type = typename fixed_vector<T, N, scalar_traits>::scalar_type;
+  static_assert(sizeof(fixed_vector<T, N, scalar_traits>) % sizeof(scalar_type) == 0, "component_view: fixed_vector has padding that is not a whole element");
+  if (k >= N) {
+    throw std::out_of_range("component_view: k >= N");
+  }
+  if (count == 0) {
+    return vector<T, scalar_traits>();
+  }
+  constexpr int step = static_cast<int>(sizeof(fixed_vector<T, N, scalar_traits>) / sizeof(scalar_type));
+  return vector<T, scalar_traits>(first->data() + k, count, step);
+}
+
+/* as for as_vector, a view of const fixed_vectors must not be written through */
+template<typename T, std::size_t N, typename scalar_traits>
+vector<T, scalar_traits> component_view(const fixed_vector<T, N, scalar_traits>* first, std::size_t count, std::size_t k) {
+  return component_view(const_cast<fixed_vector<T, N, scalar_traits>*>(first), count, k);
+}
+}  // namespace dicek::math::linalg
+
+#endif /* UUID_E62EC40E_FB04_4AD9_90D6_9241E2BA49D9 */
@@ -0,0 +1,230 @@
+/*
+MIT License
+
+Copyright (c) 2022 Daisuke NAGAO
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#ifndef UUID_DBBB90AA_F234_470B_A008_F6BF0147E620
+#define UUID_DBBB90AA_F234_470B_A008_F6BF0147E620
+
+#include <cerrno>
+#include <cstddef>
+#include <dicek/linalg/vector.hpp>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace dicek::math::linalg {
+/*
+ * A file mapped into memory with mmap (POSIX only).
+ *
+ * view<T>() and mutable_view<T>() return vectors over external memory
+ * (constructor (3)) that refer directly to the mapped pages: nothing is read
+ * until an element is touched. Those vectors do not keep the mapping alive,
+ * so they must not outlive the mapped_file. Changes made through a
+ * read_write mapping reach the file when it is unmapped or sync() is called.
+ */
+class mapped_file {
+ public:
+  enum class mode { read_only, read_write };
+
+  /* hints passed to madvise */
+  enum class access { normal, sequential, random, will_need, dont_need };
+
+  mapped_file() noexcept = default;
+
+  explicit mapped_file(const std::string& path, mode m = mode::read_only) : mode_(m) {
+    const int fd = ::open(path.c_str(), m == mode::read_only ? O_RDONLY : O_RDWR);
+    if (fd < 0) {
+      throw std::system_error(errno, std::generic_category(), "mapped_file: cannot open " + path);
+    }
+    map(fd, path);
+  }
+
+  /* creates (or truncates) path to bytes bytes of zeros and maps it read_write */
+  static mapped_file create(const std::string& path, std::size_t bytes) {
+    const int fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+      throw std::system_error(errno, std::generic_category(), "mapped_file: cannot create " + path);
+    }
+    if (::ftruncate(fd, static_cast<off_t>(bytes)) != 0) {
+      const int error = errno;
+      ::close(fd);
+      throw std::system_error(error, std::generic_category(), "mapped_file: cannot resize " + path);
+    }
+    mapped_file f;
+    f.mode_ = mode::read_write;
+    f.map(fd, path);
+    return f;
+  }
+
+  mapped_file(const mapped_file&) = delete;
+  mapped_file& operator=(const mapped_file&) = delete;
+
+  mapped_file(mapped_file&& rhs) noexcept : data_(std::exchange(rhs.data_, nullptr)), size_(std::exchange(rhs.size_, 0)), mode_(rhs.mode_) {}
+
+  mapped_file& operator=(mapped_file&& rhs) noexcept {
+    if (this != &rhs) {
+      unmap();
+      data_ = std::exchange(rhs.data_, nullptr);
+      size_ = std::exchange(rhs.size_, 0);
+      mode_ = rhs.mode_;
+    }
+    return *this;
+  }
+
+  ~mapped_file() noexcept {
+    unmap();
+  }
+
+  /* in bytes */
+  std::size_t size() const noexcept {
+    return size_;
+  }
+
+  const void* data() const noexcept {
+    return data_;
+  }
+
+  mode get_mode() const noexcept {
+    return mode_;
+  }
+
+  void advise(access a) const {
+    if (data_ == nullptr) {
+      return;
+    }
+    if (::madvise(data_, size_, to_advice(a)) != 0) {
+      throw std::system_error(errno, std::generic_category(), "mapped_file::advise");
+    }
+  }
+
+  /* writes modified pages back to the file before returning */
+  void sync() const {
+    if (data_ != nullptr && ::msync(data_, size_, MS_SYNC) != 0) {
+      throw std::system_error(errno, std::generic_category(), "mapped_file::sync");
+    }
+  }
+
+  /*
+   * count elements of type T starting offset bytes into the file; by default
+   * all that fit. The vector is only to be read: the pages of a read_only
+   * mapping are not writable, and a write through it faults. Use
+   * mutable_view to modify a read_write mapping.
+   */
+  template<typename T, typename scalar_traits = dicek::math::scalar_traits<T>, typename storage_policy = unsynchronized_storage_policy>
+  vector<T, scalar_traits, storage_policy> view(std::size_t offset = 0, std::size_t count = npos) const {
+    return make_view<T, scalar_traits, storage_policy>(offset, count, "mapped_file::view");
+  }
+
+  template<typename T, typename scalar_traits = dicek::math::scalar_traits<T>, typename storage_policy = unsynchronized_storage_policy>
+  vector<T, scalar_traits, storage_policy> mutable_view(std::size_t offset = 0, std::size_t count = npos) {
+    if (mode_ != mode::read_write) {
+      throw std::logic_error("mapped_file::mutable_view: the file is mapped read_only");
+    }
+    return make_view<T, scalar_traits, storage_policy>(offset, count, "mapped_file::mutable_view");
+  }
+
+  static constexpr std::size_t npos = std::numeric_limits<std::size_t>::max();
+
+ private:
+  /* maps the whole file and closes fd */
+  void map(int fd, const std::string& path) {
+    struct stat st;
+    if (::fstat(fd, &st) != 0) {
+      const int error = errno;
+      ::close(fd);
+      throw std::system_error(error, std::generic_category(), "mapped_file: cannot stat " + path);
+    }
+
+    size_ = static_cast<std::size_t>(st.st_size);
+    if (size_ != 0) {
+      const int prot = mode_ == mode::read_only ? PROT_READ : PROT_READ | PROT_WRITE;
+      void* p        = ::mmap(nullptr, size_, prot, MAP_SHARED, fd, 0);
+      if (p == MAP_FAILED) {
+        const int error = errno;
+        ::close(fd);
+        size_ = 0;
+        throw std::system_error(error, std::generic_category(), "mapped_file: cannot map " + path);
+      }
+      data_ = p;
+    }
+    /* the mapping stays valid after the descriptor is closed */
+    ::close(fd);
+  }
+
+  void unmap() noexcept {
+    if (data_ != nullptr) {
+      ::munmap(data_, size_);
+      data_ = nullptr;
+      size_ = 0;
+    }
+  }
+
+  template<typename T, typename scalar_traits, typename storage_policy>
+  vector<T, scalar_traits, storage_policy> make_view(std::size_t offset, std::size_t count, const char* name) const {
+    using scalar_type = typename vector<T, scalar_traits, storage_policy>::scalar_type;
+    if (offset > size_) {
+      throw std::out_of_range(std::string(name) + ": offset > this->size()");
+    }
+    if (offset % alignof(scalar_type) != 0) {
+      throw std::invalid_argument(std::string(name) + ": offset is not aligned for the element type");
+    }
+    const std::size_t available = (size_ - offset) / sizeof(scalar_type);
+    if (count == npos) {
+      count = available;
+    } else if (count > available) {
+      throw std::out_of_range(std::string(name) + ": count exceeds the file");
+    }
+    if (count == 0) {
+      return vector<T, scalar_traits, storage_policy>();
+    }
+    return vector<T, scalar_traits, storage_policy>(reinterpret_cast<scalar_type*>(static_cast<std::byte*>(data_) + offset), count);
+  }
+
+  static int to_advice(access a) noexcept {
+    switch (a) {
+      case access::sequential:
+        return MADV_SEQUENTIAL;
+      case access::random:
+        return MADV_RANDOM;
+      case access::will_need:
+        return MADV_WILLNEED;
+      case access::dont_need:
+        return MADV_DONTNEED;
+      default:
+        return MADV_NORMAL;
+    }
+  }
+
+  void* data_       = nullptr;
+  std::size_t size_ = 0;
+  mode mode_        = mode::read_only;
+};
+}  // namespace dicek::math::linalg
+
+#endif /* UUID_DBBB90AA_F234_470B_A008_F6BF0147E620 */
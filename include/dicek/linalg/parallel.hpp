@@ -0,0 +1,104 @@
+/*
+MIT License
+
+Copyright (c) 2022 Daisuke NAGAO
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#ifndef UUID_19725A67_7EF2_4630_AB4C_9CC32415ED22
+#define UUID_19725A67_7EF2_4630_AB4C_9CC32415ED22
+
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <thread>
+#include <vector>
+
+namespace dicek::math::linalg {
+/*
+ * Execution policy for the parallel overloads of add, subtract, scale, map,
+ * dot and norm.
+ *
+ * The elements are split into one contiguous range per thread; reductions
+ * combine one partial result per range. Inputs shorter than threshold are
+ * processed serially on the calling thread.
+ */
+struct parallel_policy {
+  /* 0 means std::thread::hardware_concurrency() */
+  std::size_t threads   = 0;
+  std::size_t threshold = std::size_t(1) << 16;
+};
+
+inline constexpr parallel_policy par{};
+
+namespace detail {
+inline std::size_t thread_count(const parallel_policy& policy, std::size_t n) noexcept {
+  if (n < policy.threshold || n < 2) {
+    return 1;
+  }
+  std::size_t threads = policy.threads != 0 ? policy.threads : std::thread::hardware_concurrency();
+  return std::clamp<std::size_t>(threads, 1, n);
+}
+
+/* calls f(chunk, first, last) for `chunks` consecutive ranges covering [0, n) */
+template<typename F>
+void parallel_for(std::size_t chunks, std::size_t n, F f) {
+  const auto range = [chunks, n](std::size_t k) { return n / chunks * k + std::min(k, n % chunks); };
+
+  if (chunks == 1) {
+    f(std::size_t(0), std::size_t(0), n);
+    return;
+  }
+
+  std::vector<std::exception_ptr> errors(chunks);
+  std::vector<std::thread> workers;
+  workers.reserve(chunks - 1);
+  const auto run = [&](std::size_t k) {
+    try {
+      f(k, range(k), range(k + 1));
+    } catch (...) {
+      errors[k] = std::current_exception();
+    }
+  };
+
+  try {
+    for (std::size_t k = 1; k < chunks; ++k) {
+      workers.emplace_back(run, k);
+    }
+  } catch (...) {
+    for (auto& worker : workers) {
+      worker.join();
+    }
+    throw;
+  }
+  run(0);
+  for (auto& worker : workers) {
+    worker.join();
+  }
+
+  for (const auto& error : errors) {
+    if (error) {
+      std::rethrow_exception(error);
+    }
+  }
+}
+}  // namespace detail
+}  // namespace dicek::math::linalg
+
+#endif /* UUID_19725A67_7EF2_4630_AB4C_9CC32415ED22 */
@@ -0,0 +1,394 @@
+/*
+MIT License
+
+Copyright (c) 2022 Daisuke NAGAO
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#ifndef UUID_426D23BD_6D8A_4C94_B5C2_301400821E9B
+#define UUID_426D23BD_6D8A_4C94_B5C2_301400821E9B
+
+#include <algorithm>
+#include <array>
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <dicek/linalg/vector.hpp>
+#include <istream>
+#include <limits>
+#include <memory_resource>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+namespace dicek::math::linalg {
+/*
+ * Binary format for one vector:
+ *
+ *   offset  size  field
+ *        0     4  magic "DCKV"
+ *        4     2  format version, currently 1
+ *        6     1  element type (see detail::element_code)
+ *        7     1  flags: 1 = payload is big-endian, 2 = checksum present
+ *        8     8  number of elements
+ *       16     4  payload offset, a multiple of the requested alignment
+ *       20     4  reserved, 0
+ *       24     8  checksum of the payload bytes, 0 if absent
+ *       32        zero padding up to the payload offset
+ *
+ * Header fields are little-endian. The payload holds the elements
+ * contiguously in the writer's byte order; deserialize converts a foreign
+ * byte order, deserialize_view requires the native one. The checksum is a
+ * fast 64-bit hash meant to catch corruption, not tampering.
+ */
+struct serialization_options {
+  /* of the payload relative to the start of the header; a power of two */
+  std::size_t alignment = 64;
+  bool checksum         = true;
+};
+
+class serialization_error : public std::runtime_error {
+ public:
+  using std::runtime_error::runtime_error;
+};
+
+namespace detail {
+template<typename T>
+struct element_code;
+
+template<>
+struct element_code<float> : std::integral_constant<std::uint8_t, 1> {
+  using component_type = float;
+};
+
+template<>
+struct element_code<double> : std::integral_constant<std::uint8_t, 2> {
+  using component_type = double;
+};
+
+template<>
+struct element_code<std::complex<float>> : std::integral_constant<std::uint8_t, 3> {
+  using component_type = float;
+};
+
+template<>
+struct element_code<std::complex<double>> : std::integral_constant<std::uint8_t, 4> {
+  using component_type = double;
+};
+
+template<>
+struct element_code<std::int32_t> : std::integral_constant<std::uint8_t, 5> {
+  using component_type = std::int32_t;
+};
+
+template<>
+struct element_code<std::int64_t> : std::integral_constant<std::uint8_t, 6> {
+  using component_type = std::int64_t;
+};
+
+inline constexpr std::size_t header_size              = 32;
+inline constexpr std::uint16_t format_version         = 1;
+inline constexpr std::uint8_t big_endian_flag         = 1;
+inline constexpr std::uint8_t checksum_flag           = 2;
+inline constexpr std::array<char, 4> serialized_magic = {'D', 'C', 'K', 'V'};
+
+inline bool native_big_endian() noexcept {
+  const std::uint16_t one = 1;
+  unsigned char first;
+  std::memcpy(&first, &one, 1);
+  return first == 0;
+}
+
+inline void store_le(std::byte* p, std::uint64_t value, std::size_t bytes) noexcept {
+  for (std::size_t i = 0; i < bytes; ++i) {
+    p[i] = static_cast<std::byte>(value >> (8 * i));
+  }
+}
+
+inline std::uint64_t load_le(const std::byte* p, std::size_t bytes) noexcept {
+  std::uint64_t value = 0;
+  for (std::size_t i = 0; i < bytes; ++i) {
+    value |= std::uint64_t(std::to_integer<unsigned char>(p[i])) << (8 * i);
+  }
+  return value;
+}
+
+/* reverses the bytes of each component_size-byte component in [p, p + bytes) */
+inline void swap_byte_order(std::byte* p, std::size_t bytes, std::size_t component_size) noexcept {
+  for (std::size_t i = 0; i + component_size <= bytes; i += component_size) {
+    std::reverse(p + i, p + i + component_size);
+  }
+}
+
+/* 64-bit hash over 8-byte little-endian words, four independent lanes wide */
+class payload_hasher {
+ public:
+  void update(const std::byte* p, std::size_t n) noexcept {
+    bytes_ += n;
+    for (; n != 0 && pending_size_ != 0; --n) {
+      append_pending(*p++);
+    }
+    for (; n >= 8; p += 8, n -= 8) {
+      mix(load_word(p));
+    }
+    for (; n != 0; --n) {
+      append_pending(*p++);
+    }
+  }
+
+  std::uint64_t finish() noexcept {
+    if (pending_size_ != 0) {
+      std::fill(pending_.begin() + static_cast<std::ptrdiff_t>(pending_size_), pending_.end(), std::byte{0});
+      mix(load_word(pending_.data()));
+      pending_size_ = 0;
+    }
+    std::uint64_t h = bytes_;
+    for (const auto lane : lanes_) {
+      h = avalanche(h ^ lane);
+    }
+    return h;
+  }
+
+ private:
+  static std::uint64_t load_word(const std::byte* p) noexcept {
+    if (native_big_endian()) {
+      return load_le(p, 8);
+    }
+    std::uint64_t w;
+    std::memcpy(&w, p, 8);
+    return w;
+  }
+
+  static std::uint64_t rotl(std::uint64_t x, int r) noexcept {
+    return (x << r) | (x >> (64 - r));
+  }
+
+  static std::uint64_t avalanche(std::uint64_t h) noexcept {
+    h ^= h >> 33;
+    h *= 0xFF51AFD7ED558CCDull;
+    h ^= h >> 33;
+    h *= 0xC4CEB9FE1A85EC53ull;
+    return h ^ (h >> 33);
+  }
+
+  void mix(std::uint64_t w) noexcept {
+    auto& lane = lanes_[words_++ & 3];
+    lane       = rotl(lane ^ w, 27) * 0x9E3779B97F4A7C15ull;
+  }
+
+  void append_pending(std::byte b) noexcept {
+    pending_[pending_size_++] = b;
+    if (pending_size_ == 8) {
+      mix(load_word(pending_.data()));
+      pending_size_ = 0;
+    }
+  }
+
+  std::array<std::uint64_t, 4> lanes_ = {0x243F6A8885A308D3ull, 0x13198A2E03707344ull, 0xA4093822299F31D0ull, 0x082EFA98EC4E6C89ull};
+  std::array<std::byte, 8> pending_   = {};
+  std::size_t pending_size_           = 0;
+  std::uint64_t words_                = 0;
+  std::uint64_t bytes_                = 0;
+};
+
+/* calls f(bytes, n) on the elements of v in order, in contiguous pieces */
+template<typename V, typename F>
+void for_each_payload_chunk(const V& v, F f) {
+  using scalar_type = typename V::scalar_type;
+  if (v.is_contiguous()) {
+    f(reinterpret_cast<const std::byte*>(v.data()), v.size() * sizeof(scalar_type));
+    return;
+  }
+  std::array<scalar_type, 512> buf;
+  for (std::size_t first = 0; first < v.size(); first += buf.size()) {
+    const std::size_t n = std::min(buf.size(), v.size() - first);
+    for (std::size_t i = 0; i < n; ++i) {
+      buf[i] = v[first + i];
+    }
+    f(reinterpret_cast<const std::byte*>(buf.data()), n * sizeof(scalar_type));
+  }
+}
+
+struct serialized_header {
+  std::uint8_t code;
+  std::uint8_t flags;
+  std::uint64_t length;
+  std::uint32_t payload_offset;
+  std::uint64_t checksum;
+};
+
+template<typename scalar_type>
+serialized_header parse_header(const std::byte* p, const char* name) {
+  if (!std::equal(serialized_magic.begin(), serialized_magic.end(), reinterpret_cast<const char*>(p))) {
+    throw serialization_error(std::string(name) + ": not a serialized vector");
+  }
+  if (load_le(p + 4, 2) != format_version) {
+    throw serialization_error(std::string(name) + ": unsupported format version");
+  }
+
+  serialized_header h;
+  h.code           = static_cast<std::uint8_t>(load_le(p + 6, 1));
+  h.flags          = static_cast<std::uint8_t>(load_le(p + 7, 1));
+  h.length         = load_le(p + 8, 8);
+  h.payload_offset = static_cast<std::uint32_t>(load_le(p + 16, 4));
+  h.checksum       = load_le(p + 24, 8);
+
+  if (h.code != element_code<scalar_type>::value) {
+    throw serialization_error(std::string(name) + ": element type mismatch");
+  }
+  if (h.payload_offset < header_size) {
+    throw serialization_error(std::string(name) + ": corrupt header");
+  }
+  if (h.length > std::numeric_limits<std::size_t>::max() / sizeof(scalar_type)) {
+    throw serialization_error(std::string(name) + ": length too large");
+  }
+  return h;
+}
+
+inline void verify_checksum(const serialized_header& h, const std::byte* payload, std::size_t bytes, const char* name) {
+  if ((h.flags & checksum_flag) != 0) {
+    payload_hasher hasher;
+    hasher.update(payload, bytes);
+    if (hasher.finish() != h.checksum) {
+      throw serialization_error(std::string(name) + ": checksum mismatch");
+    }
+  }
+}
+
+inline std::size_t payload_offset(const serialization_options& options) {
+  const std::size_t a = options.alignment;
+  if (a == 0 || (a & (a - 1)) != 0 || a > (std::size_t(1) << 31)) {
+    throw std::invalid_argument("serialize: alignment must be a power of two no greater than 2^31");
+  }
+  return (header_size + a - 1) / a * a;
+}
+}  // namespace detail
+
+/* bytes serialize(out, v, options) writes */
+template<typename T, typename scalar_traits, typename storage_policy>
+std::size_t serialized_size(const vector<T, scalar_traits, storage_policy>& v, const serialization_options& options = {}) {
+  return detail::payload_offset(options) + v.size() * sizeof(typename vector<T, scalar_traits, storage_policy>::scalar_type);
+}
+
+/* writes v, which may be strided, to out; the elements are read twice if a checksum is requested */
+template<typename T, typename scalar_traits, typename storage_policy>
+void serialize(std::ostream& out, const vector<T, scalar_traits, storage_policy>& v, const serialization_options& options = {}) {
+  using scalar_type        = typename vector<T, scalar_traits, storage_policy>::scalar_type;
+  const std::size_t offset = detail::payload_offset(options);
+
+  std::uint64_t checksum = 0;
+  if (options.checksum) {
+    detail::payload_hasher hasher;
+    detail::for_each_payload_chunk(v, [&hasher](const std::byte* p, std::size_t n) { hasher.update(p, n); });
+    checksum = hasher.finish();
+  }
+
+  std::array<std::byte, detail::header_size> header = {};
+  std::copy(detail::serialized_magic.begin(), detail::serialized_magic.end(), reinterpret_cast<char*>(header.data()));
+  detail::store_le(header.data() + 4, detail::format_version, 2);
+  detail::store_le(header.data() + 6, detail::element_code<scalar_type>::value, 1);
+  detail::store_le(header.data() + 7, (detail::native_big_endian() ? detail::big_endian_flag : 0) | (options.checksum ? detail::checksum_flag : 0), 1);
+  detail::store_le(header.data() + 8, v.size(), 8);
+  detail::store_le(header.data() + 16, offset, 4);
+  detail::store_le(header.data() + 24, checksum, 8);
+  out.write(reinterpret_cast<const char*>(header.data()), static_cast<std::streamsize>(header.size()));
+
+  const std::array<char, 64> zeros = {};
+  for (std::size_t padding = offset - detail::header_size; padding != 0;) {
+    const std::size_t n = std::min(padding, zeros.size());
+    out.write(zeros.data(), static_cast<std::streamsize>(n));
+    padding -= n;
+  }
+
+  detail::for_each_payload_chunk(v, [&out](const std::byte* p, std::size_t n) { out.write(reinterpret_cast<const char*>(p), static_cast<std::streamsize>(n)); });
+  if (!out) {
+    throw serialization_error("serialize: write failed");
+  }
+}
+
+/* reads a vector written by serialize into new storage from alloc */
+template<typename T, typename scalar_traits = dicek::math::scalar_traits<T>, typename storage_policy = unsynchronized_storage_policy>
+vector<T, scalar_traits, storage_policy> deserialize(std::istream& in, std::pmr::memory_resource* alloc = std::pmr::get_default_resource()) {
+  using vector_type = vector<T, scalar_traits, storage_policy>;
+  using scalar_type = typename vector_type::scalar_type;
+
+  std::array<std::byte, detail::header_size> header;
+  if (!in.read(reinterpret_cast<char*>(header.data()), static_cast<std::streamsize>(header.size()))) {
+    throw serialization_error("deserialize: truncated header");
+  }
+  const auto h = detail::parse_header<scalar_type>(header.data(), "deserialize");
+  in.ignore(static_cast<std::streamsize>(h.payload_offset - detail::header_size));
+
+  vector_type r(static_cast<std::size_t>(h.length), default_init, alloc);
+  auto* payload       = reinterpret_cast<std::byte*>(r.data());
+  const std::size_t n = r.size() * sizeof(scalar_type);
+  if (!in.read(reinterpret_cast<char*>(payload), static_cast<std::streamsize>(n))) {
+    throw serialization_error("deserialize: truncated payload");
+  }
+  detail::verify_checksum(h, payload, n, "deserialize");
+  if (((h.flags & detail::big_endian_flag) != 0) != detail::native_big_endian()) {
+    detail::swap_byte_order(payload, n, sizeof(typename detail::element_code<scalar_type>::component_type));
+  }
+  return r;
+}
+
+/*
+ * Returns a vector over the payload inside buffer, without copying; it is
+ * valid as long as buffer is. The payload must be in native byte order and
+ * suitably aligned, which it is if buffer is aligned to the alignment it was
+ * serialized with (e.g. a mapped_file).
+ *
+ * buffer is taken as const so read-only memory can be viewed, but vector has
+ * no read-only view: the result writes through to buffer. Write through it
+ * only if buffer is writable; over a read_only mapped_file a write faults.
+ */
+template<typename T, typename scalar_traits = dicek::math::scalar_traits<T>, typename storage_policy = unsynchronized_storage_policy>
+vector<T, scalar_traits, storage_policy> deserialize_view(const void* buffer, std::size_t bytes, bool verify_checksum = true) {
+  using vector_type = vector<T, scalar_traits, storage_policy>;
+  using scalar_type = typename vector_type::scalar_type;
+
+  const auto* p = static_cast<const std::byte*>(buffer);
+  if (bytes < detail::header_size) {
+    throw serialization_error("deserialize_view: truncated header");
+  }
+  const auto h = detail::parse_header<scalar_type>(p, "deserialize_view");
+  if (((h.flags & detail::big_endian_flag) != 0) != detail::native_big_endian()) {
+    throw serialization_error("deserialize_view: payload is not in native byte order");
+  }
+  const std::size_t n = static_cast<std::size_t>(h.length) * sizeof(scalar_type);
+  if (h.payload_offset > bytes || n > bytes - h.payload_offset) {
+    throw serialization_error("deserialize_view: truncated payload");
+  }
+  const auto* payload = p + h.payload_offset;
+  if (reinterpret_cast<std::uintptr_t>(payload) % alignof(scalar_type) != 0) {
+    throw serialization_error("deserialize_view: payload is misaligned");
+  }
+  if (verify_checksum) {
+    detail::verify_checksum(h, payload, n, "deserialize_view");
+  }
+  if (h.length == 0) {
+    return vector_type();
+  }
+  return vector_type(const_cast<scalar_type*>(reinterpret_cast<const scalar_type*>(payload)), static_cast<std::size_t>(h.length));
+}
+}  // namespace dicek::math::linalg
+
+#endif /* UUID_426D23BD_6D8A_4C94_B5C2_301400821E9B */
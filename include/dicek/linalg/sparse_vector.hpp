@@ -0,0 +1,347 @@
+/*
+MIT License
+
+Copyright (c) 2022 Daisuke NAGAO
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#ifndef UUID_C19F61D8_5EA7_4EF8_8EB9_C76FCF9E1126
+#define UUID_C19F61D8_5EA7_4EF8_8EB9_C76FCF9E1126
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <dicek/linalg/detail/kernels.hpp>
+#include <dicek/linalg/vector.hpp>
+#include <dicek/scalar_traits.hpp>
+#include <initializer_list>
+#include <limits>
+#include <memory_resource>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace dicek::math::linalg {
+/*
+ * Vector of dimension() elements of which only nnz() are stored, as two
+ * parallel arrays of strictly increasing indices and their values.
+ *
+ * Both arrays come from the same memory resource. Against a contiguous
+ * floating-point vector, dot and axpy gather (and scatter) the dense
+ * elements named by the indices with SIMD; two sparse vectors are combined
+ * by merging their index arrays. Unlike vector, copies are deep.
+ */
+template<typename T, typename scalar_traits = dicek::math::scalar_traits<T>>
+class sparse_vector {
+ public:
+  using scalar_traits_type = scalar_traits;
+  using scalar_type        = typename scalar_traits::scalar_type;
+  using index_type         = std::uint32_t;
+  using dense_type         = vector<T, scalar_traits>;
+
+  explicit sparse_vector(std::size_t dimension, std::pmr::memory_resource* alloc = std::pmr::get_default_resource()) : dimension_(dimension), indices_(alloc), values_(alloc) {
+    if (dimension > std::size_t(std::numeric_limits<index_type>::max()) + 1) {
+      throw std::length_error("sparse_vector: dimension exceeds the index type");
+    }
+  }
+
+  /* entries must be given in strictly increasing index order */
+  sparse_vector(std::size_t dimension, std::initializer_list<std::pair<index_type, scalar_type>> ini, std::pmr::memory_resource* alloc = std::pmr::get_default_resource()) : sparse_vector(dimension, alloc) {
+    reserve(ini.size());
+    for (const auto& [idx, val] : ini) {
+      push_back(idx, val);
+    }
+  }
+
+  /* keeps the elements of v that are not equal to scalar_type() */
+  template<typename storage_policy>
+  static sparse_vector from_dense(const vector<T, scalar_traits, storage_policy>& v, std::pmr::memory_resource* alloc = std::pmr::get_default_resource()) {
+    sparse_vector ret(v.size(), alloc);
+    with_ranges(
+        [&ret](auto first, auto last) {
+          ret.reserve(static_cast<std::size_t>(std::count_if(first, last, [](const scalar_type& x) { return x != scalar_type(); })));
+          for (auto it = first; it != last; ++it) {
+            if (*it != scalar_type()) {
+              ret.indices_.push_back(static_cast<index_type>(it - first));
+              ret.values_.push_back(*it);
+            }
+          }
+        },
+        v);
+    return ret;
+  }
+
+  dense_type to_dense(std::pmr::memory_resource* alloc) const {
+    dense_type ret(dimension_, alloc);
+    auto* const r = ret.data();
+    for (std::size_t k = 0; k < nnz(); ++k) {
+      r[indices_[k]] = values_[k];
+    }
+    return ret;
+  }
+
+  dense_type to_dense() const {
+    return to_dense(get_allocator());
+  }
+
+  std::size_t size() const noexcept {
+    return dimension_;
+  }
+
+  std::size_t nnz() const noexcept {
+    return indices_.size();
+  }
+
+  const index_type* indices() const noexcept {
+    return indices_.data();
+  }
+
+  const scalar_type* values() const noexcept {
+    return values_.data();
+  }
+
+  /* the stored values as a contiguous vector; writes through it change this sparse_vector */
+  dense_type values_view() {
+    return dense_type(values_.data(), values_.size());
+  }
+
+  /* must not be written through */
+  dense_type values_view() const {
+    return const_cast<sparse_vector*>(this)->values_view();
+  }
+
+  /* scalar_type() for indices that are not stored */
+  scalar_type operator[](std::size_t idx) const {
+    const auto it = find(idx);
+    return it != indices_.end() && *it == idx ? values_[it - indices_.begin()] : scalar_type();
+  }
+
+  scalar_type at(std::size_t idx) const {
+    if (idx >= dimension_) {
+      throw std::out_of_range("sparse_vector::at: index out of range");
+    }
+    return (*this)[idx];
+  }
+
+  /* appends an entry after the last stored one; O(1) amortized */
+  void push_back(std::size_t idx, scalar_type val) {
+    if (idx >= dimension_) {
+      throw std::out_of_range("sparse_vector::push_back: index out of range");
+    }
+    if (!indices_.empty() && idx <= indices_.back()) {
+      throw std::invalid_argument("sparse_vector::push_back: indices must be strictly increasing");
+    }
+    indices_.push_back(static_cast<index_type>(idx));
+    values_.push_back(val);
+  }
+
+  /* stores val at idx, inserting a new entry if there is none; O(nnz) */
+  void set(std::size_t idx, scalar_type val) {
+    if (idx >= dimension_) {
+      throw std::out_of_range("sparse_vector::set: index out of range");
+    }
+    const auto it  = find(idx);
+    const auto pos = it - indices_.begin();
+    if (it != indices_.end() && *it == idx) {
+      values_[pos] = val;
+      return;
+    }
+    values_.insert(values_.begin() + pos, val);
+    try {
+      indices_.insert(it, static_cast<index_type>(idx));
+    } catch (...) {
+      values_.erase(values_.begin() + pos);
+      throw;
+    }
+  }
+
+  void reserve(std::size_t count) {
+    indices_.reserve(count);
+    values_.reserve(count);
+  }
+
+  /* removes every entry; the dimension is kept */
+  void clear() noexcept {
+    indices_.clear();
+    values_.clear();
+  }
+
+  std::pmr::memory_resource* get_allocator() const noexcept {
+    return indices_.get_allocator().resource();
+  }
+
+ private:
+  typename std::pmr::vector<index_type>::const_iterator find(std::size_t idx) const {
+    return std::lower_bound(indices_.begin(), indices_.end(), idx, [](index_type lhs, std::size_t rhs) { return lhs < rhs; });
+  }
+
+  std::size_t dimension_;
+  std::pmr::vector<index_type> indices_;
+  std::pmr::vector<scalar_type> values_;
+};
+
+namespace detail {
+template<typename T, typename scalar_traits, typename storage_policy>
+void validate_sparse_size(const sparse_vector<T, scalar_traits>& x, const vector<T, scalar_traits, storage_policy>& y, const char* name) {
+  if (x.size() != y.size()) {
+    throw std::invalid_argument(std::string(name) + ": size mismatch");
+  }
+}
+
+/* the gather kernels take signed 32-bit offsets */
+template<typename T, typename scalar_traits, typename storage_policy>
+bool can_gather(const vector<T, scalar_traits, storage_policy>& y) noexcept {
+  return std::is_floating_point_v<typename scalar_traits::scalar_type> && y.is_contiguous() && y.size() <= std::size_t(std::numeric_limits<std::int32_t>::max()) + 1;
+}
+}  // namespace detail
+
+/* sum of x[i] * conj(y[i]) over the stored entries of x */
+template<typename T, typename scalar_traits, typename storage_policy>
+detail::dot_result_t<scalar_traits> dot(const sparse_vector<T, scalar_traits>& lhs, const vector<T, scalar_traits, storage_policy>& rhs) {
+  detail::validate_sparse_size(lhs, rhs, "dot");
+  using scalar_type      = typename scalar_traits::scalar_type;
+  using accumulator_type = accumulator_type_of_t<scalar_traits>;
+  if constexpr (std::is_floating_point_v<scalar_type>) {
+    if (detail::can_gather(rhs)) {
+      return static_cast<detail::dot_result_t<scalar_traits>>(detail::gather_dot<scalar_type, accumulator_type>(lhs.values(), lhs.indices(), rhs.data(), lhs.nnz()));
+    }
+  }
+
+  accumulator_type ret = {};
+  for (std::size_t k = 0; k < lhs.nnz(); ++k) {
+    ret += static_cast<accumulator_type>(lhs.values()[k]) * static_cast<accumulator_type>(scalar_traits::conj(rhs[lhs.indices()[k]]));
+  }
+  return static_cast<detail::dot_result_t<scalar_traits>>(ret);
+}
+
+template<typename T, typename scalar_traits, typename storage_policy>
+detail::dot_result_t<scalar_traits> dot(const vector<T, scalar_traits, storage_policy>& lhs, const sparse_vector<T, scalar_traits>& rhs) {
+  detail::validate_sparse_size(rhs, lhs, "dot");
+  using scalar_type      = typename scalar_traits::scalar_type;
+  using accumulator_type = accumulator_type_of_t<scalar_traits>;
+  if constexpr (std::is_floating_point_v<scalar_type>) {
+    if (detail::can_gather(lhs)) {
+      return static_cast<detail::dot_result_t<scalar_traits>>(detail::gather_dot<scalar_type, accumulator_type>(rhs.values(), rhs.indices(), lhs.data(), rhs.nnz()));
+    }
+  }
+
+  accumulator_type ret = {};
+  for (std::size_t k = 0; k < rhs.nnz(); ++k) {
+    ret += static_cast<accumulator_type>(lhs[rhs.indices()[k]]) * static_cast<accumulator_type>(scalar_traits::conj(rhs.values()[k]));
+  }
+  return static_cast<detail::dot_result_t<scalar_traits>>(ret);
+}
+
+/*
+ * Sum over the indices stored in both. The index arrays are merged; when one
+ * side is much shorter, each of its indices is binary-searched in the rest
+ * of the other instead.
+ */
+template<typename T, typename scalar_traits>
+detail::dot_result_t<scalar_traits> dot(const sparse_vector<T, scalar_traits>& lhs, const sparse_vector<T, scalar_traits>& rhs) {
+  if (lhs.size() != rhs.size()) {
+    throw std::invalid_argument("dot: size mismatch");
+  }
+
+  using accumulator_type = accumulator_type_of_t<scalar_traits>;
+  using index_type       = typename sparse_vector<T, scalar_traits>::index_type;
+  const auto product     = [&](std::size_t i, std::size_t j) { return static_cast<accumulator_type>(lhs.values()[i]) * static_cast<accumulator_type>(scalar_traits::conj(rhs.values()[j])); };
+  const index_type* a    = lhs.indices();
+  const index_type* b    = rhs.indices();
+  const std::size_t m    = lhs.nnz();
+  const std::size_t n    = rhs.nnz();
+  accumulator_type ret   = {};
+
+  constexpr std::size_t search_ratio = 16;
+  if (m * search_ratio < n || n * search_ratio < m) {
+    const bool lhs_shorter = m < n;
+    const index_type* s    = lhs_shorter ? a : b;
+    const index_type* l    = lhs_shorter ? b : a;
+    const index_type* last = l + (lhs_shorter ? n : m);
+    const index_type* it   = l;
+    for (std::size_t k = 0; k < (lhs_shorter ? m : n); ++k) {
+      it = std::lower_bound(it, last, s[k]);
+      if (it == last) {
+        break;
+      }
+      if (*it == s[k]) {
+        const std::size_t j = it - l;
+        ret += lhs_shorter ? product(k, j) : product(j, k);
+      }
+    }
+    return static_cast<detail::dot_result_t<scalar_traits>>(ret);
+  }
+
+  /* each cursor steps past the smaller index, or both past a match */
+  std::size_t i = 0;
+  std::size_t j = 0;
+  while (i < m && j < n) {
+    const index_type ia = a[i];
+    const index_type jb = b[j];
+    if (ia == jb) {
+      ret += product(i, j);
+    }
+    i += ia <= jb;
+    j += jb <= ia;
+  }
+  return static_cast<detail::dot_result_t<scalar_traits>>(ret);
+}
+
+/* y[i] += alpha * x[i] over the stored entries of x */
+template<typename T, typename scalar_traits, typename storage_policy>
+vector<T, scalar_traits, storage_policy>& axpy(typename scalar_traits::scalar_type alpha, const sparse_vector<T, scalar_traits>& x, vector<T, scalar_traits, storage_policy>& y) {
+  detail::validate_sparse_size(x, y, "axpy");
+  if constexpr (std::is_floating_point_v<typename scalar_traits::scalar_type>) {
+    if (detail::can_gather(y)) {
+      detail::scatter_axpy(alpha, x.values(), x.indices(), y.data(), x.nnz());
+      return y;
+    }
+  }
+
+  for (std::size_t k = 0; k < x.nnz(); ++k) {
+    y[x.indices()[k]] += alpha * x.values()[k];
+  }
+  return y;
+}
+
+/* the unstored elements are zero, so every norm is the norm of the stored values */
+template<typename T, typename scalar_traits>
+auto norm1(const sparse_vector<T, scalar_traits>& v) {
+  return norm1(v.values_view());
+}
+
+template<typename T, typename scalar_traits>
+auto norm2(const sparse_vector<T, scalar_traits>& v) {
+  return norm2(v.values_view());
+}
+
+template<typename T, typename scalar_traits>
+auto norm_inf(const sparse_vector<T, scalar_traits>& v) {
+  return norm_inf(v.values_view());
+}
+
+template<typename T, typename scalar_traits, typename scalar>
+auto norm(const sparse_vector<T, scalar_traits>& v, scalar p) {
+  return norm(v.values_view(), p);
+}
+}  // namespace dicek::math::linalg
+
+#endif /* UUID_C19F61D8_5EA7_4EF8_8EB9_C76FCF9E1126 */
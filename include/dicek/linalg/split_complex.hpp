@@ -0,0 +1,274 @@
+/*
+MIT License
+
+Copyright (c) 2016 Daisuke NAGAO
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#ifndef UUID_D1D5A8A9_E322_4870_8836_CFC96C237DD1
+#define UUID_D1D5A8A9_E322_4870_8836_CFC96C237DD1
+
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+#include <dicek/linalg/detail/kernels.hpp>
+#include <dicek/linalg/storage_policy.hpp>
+#include <dicek/linalg/vector.hpp>
+#include <dicek/scalar_traits.hpp>
+#include <memory_resource>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+namespace dicek::math::linalg {
+/* strided view of the real parts of an interleaved complex vector */
+template<typename U, typename scalar_traits, typename storage_policy>
+vector<U> real_view(vector<std::complex<U>, scalar_traits, storage_policy>& v) {
+  if (v.step() > INT_MAX / 2 || v.step() < INT_MIN / 2) {
+    throw std::length_error("real_view: step too large for a strided view");
+  }
+  return vector<U>(reinterpret_cast<U*>(v.data()), v.size(), static_cast<int>(2 * v.step()));
+}
+
+/* strided view of the imaginary parts of an interleaved complex vector */
+template<typename U, typename scalar_traits, typename storage_policy>
+vector<U> imag_view(vector<std::complex<U>, scalar_traits, storage_policy>& v) {
+  if (v.step() > INT_MAX / 2 || v.step() < INT_MIN / 2) {
+    throw std::length_error("imag_view: step too large for a strided view");
+  }
+  return vector<U>(reinterpret_cast<U*>(v.data()) + 1, v.size(), static_cast<int>(2 * v.step()));
+}
+
+template<typename U>
+class split_complex_vector;
+
+namespace detail {
+/*
+ * The split kernels read a lane of x before writing the same lane of y, so
+ * each part of x must either be the corresponding part of y or share no
+ * storage with y at all.
+ */
+template<typename U>
+bool parts_overlap(const split_complex_vector<U>& x, const split_complex_vector<U>& y) noexcept {
+  using access = vector_access;
+  return access::overlaps_partially(x.real(), y.real()) || access::overlaps_partially(x.imag(), y.imag()) || access::may_share_storage(x.real(), y.imag()) || access::may_share_storage(x.imag(), y.real());
+}
+}  // namespace detail
+
+/*
+ * Complex vector stored as two real vectors, the real parts and the
+ * imaginary parts, so complex arithmetic runs as real SIMD arithmetic.
+ *
+ * Owned parts are contiguous and start on cache-line boundaries in one
+ * block. Any two real vectors of equal size can also serve as the parts,
+ * for instance real_view and imag_view of an interleaved vector; strided
+ * parts fall back to element loops. Like vector, copies share storage.
+ */
+template<typename U>
+class split_complex_vector {
+ public:
+  using value_type = std::complex<U>;
+  using real_type  = U;
+  using part_type  = vector<U>;
+
+  static_assert(std::is_floating_point_v<U>, "split_complex_vector: U must be a floating-point type");
+
+  split_complex_vector() : split_complex_vector(0) {}
+
+  /* length zeros */
+  explicit split_complex_vector(std::size_t length, std::pmr::memory_resource* alloc = std::pmr::get_default_resource())
+      : storage_(2 * leading_dimension(length), alloc), re_(storage_.data(), length), im_(storage_.data() + leading_dimension(length), length) {}
+
+  /* uses re and im as the parts without copying */
+  split_complex_vector(part_type re, part_type im) : re_(std::move(re)), im_(std::move(im)) {
+    if (re_.size() != im_.size()) {
+      throw std::invalid_argument("split_complex_vector: size mismatch");
+    }
+  }
+
+  template<typename scalar_traits, typename storage_policy>
+  static split_complex_vector from_interleaved(const vector<value_type, scalar_traits, storage_policy>& v, std::pmr::memory_resource* alloc = std::pmr::get_default_resource()) {
+    split_complex_vector ret(v.size(), alloc);
+    with_ranges(
+        [](auto first, auto last, auto re, auto im) {
+          for (; first != last; ++first, ++re, ++im) {
+            *re = first->real();
+            *im = first->imag();
+          }
+        },
+        v, ret.re_, ret.im_);
+    return ret;
+  }
+
+  vector<value_type> to_interleaved(std::pmr::memory_resource* alloc = std::pmr::get_default_resource()) const {
+    vector<value_type> ret(size(), default_init, alloc);
+    with_ranges([](auto re, auto last, auto im, auto out) { std::transform(re, last, im, out, [](U a, U b) { return value_type(a, b); }); }, re_, im_, ret);
+    return ret;
+  }
+
+  std::size_t size() const noexcept {
+    return re_.size();
+  }
+
+  bool is_contiguous() const noexcept {
+    return re_.is_contiguous() && im_.is_contiguous();
+  }
+
+  value_type operator[](std::size_t idx) const {
+    return value_type(re_[idx], im_[idx]);
+  }
+
+  void set(std::size_t idx, const value_type& val) {
+    re_[idx] = val.real();
+    im_[idx] = val.imag();
+  }
+
+  /* the parts themselves; writes through them change this vector, so the parts of a const vector must not be written through */
+  part_type real() const {
+    return re_;
+  }
+
+  part_type imag() const {
+    return im_;
+  }
+
+  split_complex_vector clone(std::pmr::memory_resource* alloc = std::pmr::get_default_resource()) const {
+    split_complex_vector ret(size(), alloc);
+    ret.re_.assign(lazy(re_));
+    ret.im_.assign(lazy(im_));
+    return ret;
+  }
+
+  /* val * (*this) in new storage */
+  split_complex_vector scale(const value_type& val) const {
+    split_complex_vector ret(size());
+    scale_into(val, ret);
+    return ret;
+  }
+
+  split_complex_vector& operator*=(const value_type& val) {
+    scale_into(val, *this);
+    return *this;
+  }
+
+ private:
+  using storage_type = vector<U, scalar_traits<U>, aligned_storage_policy<64>>;
+
+  static std::size_t leading_dimension(std::size_t length) {
+    constexpr std::size_t per_line = 64 / sizeof(U);
+    if (length > SIZE_MAX / 2 - per_line) {
+      throw std::bad_array_new_length();
+    }
+    return (length + per_line - 1) / per_line * per_line;
+  }
+
+  void scale_into(const value_type& val, split_complex_vector& dst) const {
+    if (detail::parts_overlap(*this, dst)) {
+      clone().scale_into(val, dst);
+      return;
+    }
+    if (is_contiguous() && dst.is_contiguous()) {
+      detail::complex_scale(val.real(), val.imag(), re_.data(), im_.data(), dst.re_.data(), dst.im_.data(), size());
+      return;
+    }
+    for (std::size_t i = 0; i < size(); ++i) {
+      const value_type z = (*this)[i] * val;
+      dst.set(i, z);
+    }
+  }
+
+  storage_type storage_;
+  part_type re_;
+  part_type im_;
+};
+
+/* sum of x[i] * conj(y[i]), accumulated in the traits' accumulator_type of U */
+template<typename U>
+std::complex<U> dot(const split_complex_vector<U>& x, const split_complex_vector<U>& y) {
+  if (x.size() != y.size()) {
+    throw std::invalid_argument("dot: size mismatch");
+  }
+
+  using accumulator_type = accumulator_type_of_t<scalar_traits<U>>;
+  accumulator_type re    = {};
+  accumulator_type im    = {};
+  if (x.is_contiguous() && y.is_contiguous()) {
+    detail::complex_dot<U, accumulator_type>(x.real().data(), x.imag().data(), y.real().data(), y.imag().data(), x.size(), re, im);
+  } else {
+    const auto xr = x.real();
+    const auto xi = x.imag();
+    const auto yr = y.real();
+    const auto yi = y.imag();
+    for (std::size_t i = 0; i < x.size(); ++i) {
+      re += static_cast<accumulator_type>(xr[i]) * yr[i] + static_cast<accumulator_type>(xi[i]) * yi[i];
+      im += static_cast<accumulator_type>(xi[i]) * yr[i] - static_cast<accumulator_type>(xr[i]) * yi[i];
+    }
+  }
+  return std::complex<U>(static_cast<U>(re), static_cast<U>(im));
+}
+
+/* y += alpha * x */
+template<typename U>
+split_complex_vector<U>& axpy(const std::complex<U>& alpha, const split_complex_vector<U>& x, split_complex_vector<U>& y) {
+  if (x.size() != y.size()) {
+    throw std::invalid_argument("axpy: size mismatch");
+  }
+
+  if (detail::parts_overlap(x, y)) {
+    return axpy(alpha, x.clone(), y);
+  }
+  if (x.is_contiguous() && y.is_contiguous()) {
+    auto yr = y.real();
+    auto yi = y.imag();
+    detail::complex_axpy(alpha.real(), alpha.imag(), x.real().data(), x.imag().data(), yr.data(), yi.data(), x.size());
+    return y;
+  }
+  for (std::size_t i = 0; i < x.size(); ++i) {
+    y.set(i, y[i] + alpha * x[i]);
+  }
+  return y;
+}
+
+/* Euclidean norm, from the norms of the two parts so that it inherits their overflow protection */
+template<typename U>
+U norm2(const split_complex_vector<U>& v) {
+  return std::hypot(norm2(v.real()), norm2(v.imag()));
+}
+
+/* max of |v[i]| */
+template<typename U>
+U norm_inf(const split_complex_vector<U>& v) {
+  const auto re = v.real();
+  const auto im = v.imag();
+  U ret         = 0;
+  for (std::size_t i = 0; i < v.size(); ++i) {
+    const U a = std::hypot(re[i], im[i]);
+    if (a > ret || a != a) {
+      ret = a;
+    }
+  }
+  return ret;
+}
+}  // namespace dicek::math::linalg
+
+#endif /* UUID_D1D5A8A9_E322_4870_8836_CFC96C237DD1 */
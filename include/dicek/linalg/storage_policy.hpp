@@ -0,0 +1,160 @@
+/*
+MIT License
+
+Copyright (c) 2022 Daisuke NAGAO
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#ifndef UUID_5AA4C120_95DF_4968_B082_A12EABC8628B
+#define UUID_5AA4C120_95DF_4968_B082_A12EABC8628B
+
+#include <atomic>
+#include <cstddef>
+#include <type_traits>
+
+namespace dicek::math::linalg {
+/*
+ * Storage policies decide how copies of a vector share their buffer.
+ *
+ * counter_type is the reference count stored next to the buffer;
+ * increment, decrement (returning the new count) and load are the only
+ * operations the vector performs on it. A policy may also define
+ * inline_capacity (see small_buffer_policy), which defaults to 0,
+ * copy_on_write (see copy_on_write_policy), which defaults to false, and
+ * alignment (see aligned_storage_policy), which defaults to alignof the
+ * element type.
+ */
+
+/* plain counter; copies of one vector must stay on one thread */
+struct unsynchronized_storage_policy {
+  using counter_type = std::size_t;
+
+  static void increment(counter_type& count) noexcept {
+    ++count;
+  }
+
+  static std::size_t decrement(counter_type& count) noexcept {
+    return --count;
+  }
+
+  static std::size_t load(const counter_type& count) noexcept {
+    return count;
+  }
+};
+
+/* atomic counter; copies may be handed to and released on other threads */
+struct synchronized_storage_policy {
+  using counter_type = std::atomic<std::size_t>;
+
+  static void increment(counter_type& count) noexcept {
+    count.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  static std::size_t decrement(counter_type& count) noexcept {
+    return count.fetch_sub(1, std::memory_order_acq_rel) - 1;
+  }
+
+  static std::size_t load(const counter_type& count) noexcept {
+    return count.load(std::memory_order_acquire);
+  }
+};
+
+/*
+ * Vectors of at most N elements keep them inside the vector object and never
+ * touch the memory_resource. Such inline vectors do not share storage: a copy
+ * copies the elements, a move moves them (so data() changes), and ref_count()
+ * always reports 1. Longer vectors are shared through base as usual.
+ */
+template<std::size_t N, typename base = unsynchronized_storage_policy>
+struct small_buffer_policy : base {
+  static constexpr std::size_t inline_capacity = N;
+};
+
+/*
+ * Copies share the buffer until one of them is written to: the first mutable
+ * access (non-const operator[], at, data, begin or end, or any in-place
+ * operation) on a vector whose ref_count() > 1 gives that vector its own
+ * clone. References, pointers and iterators taken before the copy was made
+ * are not tracked and still write to the shared buffer.
+ */
+template<typename base = unsynchronized_storage_policy>
+struct copy_on_write_policy : base {
+  static constexpr bool copy_on_write = true;
+};
+
+/*
+ * Aligns the first element of every owned buffer, heap or inline, to
+ * Alignment bytes: e.g. 32 for AVX loads, 64 for a cache line, 4096 for a
+ * page. Heap blocks keep the reference count in front of the elements, so
+ * each one spends up to Alignment bytes on padding. Views over external
+ * memory (constructor (3)) keep whatever alignment their buffer has.
+ */
+template<std::size_t Alignment, typename base = unsynchronized_storage_policy>
+struct aligned_storage_policy : base {
+  static_assert(Alignment != 0 && (Alignment & (Alignment - 1)) == 0, "aligned_storage_policy: Alignment must be a power of two");
+  static constexpr std::size_t alignment = Alignment;
+};
+
+template<typename storage_policy, typename = void>
+struct inline_capacity_of : std::integral_constant<std::size_t, 0> {};
+
+template<typename storage_policy>
+struct inline_capacity_of<storage_policy, std::void_t<decltype(storage_policy::inline_capacity)>> : std::integral_constant<std::size_t, storage_policy::inline_capacity> {};
+
+template<typename storage_policy, typename = void>
+struct is_copy_on_write : std::false_type {};
+
+template<typename storage_policy>
+struct is_copy_on_write<storage_policy, std::void_t<decltype(storage_policy::copy_on_write)>> : std::bool_constant<storage_policy::copy_on_write> {};
+
+template<typename storage_policy, typename = void>
+struct storage_alignment_of : std::integral_constant<std::size_t, 1> {};
+
+template<typename storage_policy>
+struct storage_alignment_of<storage_policy, std::void_t<decltype(storage_policy::alignment)>> : std::integral_constant<std::size_t, storage_policy::alignment> {};
+
+namespace detail {
+template<typename T, std::size_t N, std::size_t Alignment = alignof(T)>
+class inline_buffer {
+ protected:
+  T* inline_data() noexcept {
+    return reinterpret_cast<T*>(storage_);
+  }
+  const T* inline_data() const noexcept {
+    return reinterpret_cast<const T*>(storage_);
+  }
+
+ private:
+  alignas(Alignment > alignof(T) ? Alignment : alignof(T)) std::byte storage_[N * sizeof(T)];
+};
+
+template<typename T, std::size_t Alignment>
+class inline_buffer<T, 0, Alignment> {
+ protected:
+  T* inline_data() noexcept {
+    return nullptr;
+  }
+  const T* inline_data() const noexcept {
+    return nullptr;
+  }
+};
+}  // namespace detail
+}  // namespace dicek::math::linalg
+
+#endif /* UUID_5AA4C120_95DF_4968_B082_A12EABC8628B */
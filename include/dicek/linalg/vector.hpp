@@ -24,12 +24,21 @@ SOFTWARE.
 
 #include <algorithm>
 #include <cmath>
+#include <complex>
 #include <cstddef>
+#include <cstring>
+#include <dicek/linalg/detail/kernels.hpp>
+#include <dicek/linalg/expression.hpp>
+#include <dicek/linalg/parallel.hpp>
+#include <dicek/linalg/storage_policy.hpp>
 #include <dicek/scalar_traits.hpp>
 #include <functional>
 #include <initializer_list>
 #include <iterator>
+#include <limits>
+#include <memory>
 #include <memory_resource>
+#include <new>
 #include <optional>
 #include <stdexcept>
 #include <string>
@@ -38,11 +47,107 @@ SOFTWARE.
 #include <vector>
 
 namespace dicek::math::linalg {
-template<typename T, typename scalar_traits = dicek::math::scalar_traits<T>>
-class vector {
+/* selects constructor (7): trivially default-constructible elements are left uninitialized */
+struct default_init_t {
+  explicit default_init_t() = default;
+};
+inline constexpr default_init_t default_init{};
+
+namespace detail {
+/* p as a pointer to the traits' kernel_type; unchanged when there is none */
+template<typename scalar_traits, typename P>
+auto kernel_pointer(P* p) noexcept {
+  using kernel_type = typename kernel_traits<scalar_traits>::kernel_type;
+  if constexpr (kernel_traits<scalar_traits>::has_kernels && !std::is_same_v<std::remove_const_t<P>, kernel_type>) {
+    return reinterpret_cast<std::conditional_t<std::is_const_v<P>, const kernel_type*, kernel_type*>>(p);
+  } else {
+    return p;
+  }
+}
+
+template<typename scalar_traits>
+auto kernel_value(const typename scalar_traits::scalar_type& val) noexcept {
+  using kernel_type = typename kernel_traits<scalar_traits>::kernel_type;
+  if constexpr (kernel_traits<scalar_traits>::has_kernels && !std::is_same_v<typename scalar_traits::scalar_type, kernel_type>) {
+    kernel_type ret;
+    std::memcpy(&ret, &val, sizeof(ret));
+    return ret;
+  } else {
+    return val;
+  }
+}
+
+template<typename F>
+decltype(auto) with_begins(F&& f) {
+  return f();
+}
+
+/* f(first, rest...) with first a plain pointer when v is contiguous and a strided iterator otherwise */
+template<typename F, typename V, typename... Vs>
+decltype(auto) with_begins(F&& f, V& v, Vs&... vs) {
+  if (v.is_contiguous()) {
+    const auto first = v.data();
+    return with_begins([&](auto... rest) -> decltype(auto) { return f(first, rest...); }, vs...);
+  }
+  const auto first = v.begin();
+  return with_begins([&](auto... rest) -> decltype(auto) { return f(first, rest...); }, vs...);
+}
+
+/* the aliasing checks of vector, for the in-place routines built on top of it */
+struct vector_access {
+  template<typename V>
+  static bool has_identical_element_mapping(const V& x, const V& y) noexcept {
+    return x.has_identical_element_mapping(y);
+  }
+
+  template<typename V>
+  static bool may_share_storage(const V& x, const V& y) noexcept {
+    return x.may_share_storage_with(y);
+  }
+
+  template<typename V>
+  static bool overlaps_partially(const V& x, const V& y) noexcept {
+    return x.overlaps_partially(y);
+  }
+
+  /* a copy of x allocated where the results of x's operations are */
+  template<typename V>
+  static V snapshot(const V& x) {
+    return x.clone(x.result_allocator());
+  }
+};
+}  // namespace detail
+
+/*
+ * Calls f(first, last, first_1, ..., first_k), where [first, last) spans the
+ * elements of v and first_i begins those of the i-th of vs, all of the same
+ * size. Each is a plain pointer when its vector is contiguous and a strided
+ * iterator otherwise, chosen at run time, so std:: algorithms called in f
+ * lower to memmove and vectorized loops on step-1 vectors. Mutable vectors
+ * are detached first. Every instantiation of f must return the same type.
+ */
+template<typename F, typename V, typename... Vs>
+decltype(auto) with_ranges(F&& f, V& v, Vs&... vs) {
+  if (((vs.size() != v.size()) || ...)) {
+    throw std::invalid_argument("with_ranges: size mismatch");
+  }
+  const auto n = static_cast<std::ptrdiff_t>(v.size());
+  return detail::with_begins([&](auto first, auto... rest) -> decltype(auto) { return f(first, first + n, rest...); }, v, vs...);
+}
+
+template<typename T, typename scalar_traits = dicek::math::scalar_traits<T>, typename storage_policy = unsynchronized_storage_policy>
+class vector : private detail::inline_buffer<typename scalar_traits::scalar_type, inline_capacity_of<storage_policy>::value, storage_alignment_of<storage_policy>::value> {
  public:
-  using scalar_traits_type = scalar_traits;
-  using scalar_type        = typename scalar_traits::scalar_type;
+  using scalar_traits_type  = scalar_traits;
+  using scalar_type         = typename scalar_traits::scalar_type;
+  using storage_policy_type = storage_policy;
+  using kernel_traits_type  = kernel_traits<scalar_traits>;
+
+  static constexpr std::size_t inline_capacity = inline_capacity_of<storage_policy>::value;
+  /* alignment of data() for every vector that owns its elements */
+  static constexpr std::size_t alignment = storage_alignment_of<storage_policy>::value > alignof(scalar_type) ? storage_alignment_of<storage_policy>::value : alignof(scalar_type);
+  /* elements the kernels process per instruction; 1 when they run plain loops */
+  static constexpr std::size_t simd_width = detail::simd_width<typename kernel_traits_type::kernel_type>::value;
 
   template<typename pointer_type>
   class strided_iterator {
@@ -168,20 +273,14 @@ class vector {
   vector() : length_(0), allocator_(), ref_count_(nullptr), elm_(nullptr), step_(1) {};
   /* constructor (2) */
   vector(std::size_t length, std::pmr::memory_resource* alloc = std::pmr::get_default_resource()) : length_(length), allocator_(alloc), ref_count_(nullptr), elm_(nullptr), step_(1) {
+    acquire_storage();
+
     using scalar_type_allocator_type                 = typename std::allocator_traits<std::pmr::polymorphic_allocator<std::byte>>::template rebind_alloc<scalar_type>;
     using scalar_type_allocator_traits               = std::allocator_traits<scalar_type_allocator_type>;
     scalar_type_allocator_type scalar_type_allocator = allocator_;
-    elm_                                             = scalar_type_allocator_traits::allocate(scalar_type_allocator, length_);
     for (std::size_t i = 0; i < length_; ++i) {
       scalar_type_allocator_traits::construct(scalar_type_allocator, elm_ + i);
     }
-
-    using size_t_allocator_type            = typename std::allocator_traits<std::pmr::polymorphic_allocator<std::byte>>::template rebind_alloc<size_t>;
-    using size_t_allocator_traits          = std::allocator_traits<size_t_allocator_type>;
-    size_t_allocator_type size_t_allocator = allocator_;
-    ref_count_                             = size_t_allocator_traits::allocate(size_t_allocator, 1);
-    size_t_allocator_traits::construct(size_t_allocator, ref_count_);
-    ++*ref_count_;
   }
   /* constructor (3) */
   vector(scalar_type* buf, std::size_t length, int step = 1) : length_(length), allocator_(std::pmr::null_memory_resource()), ref_count_(nullptr), elm_(buf), step_(step) {
@@ -190,46 +289,66 @@ class vector {
     }
   }
   /* constructor (4) */
-  vector(std::initializer_list<scalar_type> ini, std::pmr::memory_resource* alloc = std::pmr::get_default_resource()) : vector(ini.size(), alloc) {
-    std::copy(std::begin(ini), std::end(ini), std::begin(*this));
+  vector(std::initializer_list<scalar_type> ini, std::pmr::memory_resource* alloc = std::pmr::get_default_resource()) : vector(ini.size(), default_init, alloc) {
+    std::copy(std::begin(ini), std::end(ini), elm_);
+  }
+  /* constructor (5) */
+  template<typename E>
+  vector(const vector_expression<E>& e) : vector(e, result_allocator(e.self().get_allocator())) {}
+  /* constructor (6) */
+  template<typename E>
+  vector(const vector_expression<E>& e, std::pmr::memory_resource* alloc) : vector(e.size(), default_init, alloc) {
+    static_assert(std::is_same_v<typename E::vector_type, vector>, "vector::vector: expression has a different vector type");
+    const auto& expr = e.self();
+    for (std::size_t i = 0; i < length_; ++i) {
+      elm_[i] = expr[i];
+    }
+  }
+  /* constructor (7) */
+  vector(std::size_t length, default_init_t, std::pmr::memory_resource* alloc = std::pmr::get_default_resource()) : length_(length), allocator_(alloc), ref_count_(nullptr), elm_(nullptr), step_(1) {
+    acquire_storage();
+
+    if constexpr (!std::is_trivially_default_constructible_v<scalar_type>) {
+      for (std::size_t i = 0; i < length_; ++i) {
+        ::new (static_cast<void*>(elm_ + i)) scalar_type;
+      }
+    }
   }
   /* copy constructor */
   vector(const vector& rhs) : length_(rhs.length_), allocator_(rhs.allocator_), ref_count_(rhs.ref_count_), elm_(rhs.elm_), step_(rhs.step_) {
-    if (ref_count_ != nullptr) {
-      ++*ref_count_;
+    if (rhs.is_inline()) {
+      elm_ = this->inline_data();
+      if constexpr (kernel_traits_type::is_trivially_copyable) {
+        std::memcpy(static_cast<void*>(elm_), static_cast<const void*>(rhs.elm_), length_ * sizeof(scalar_type));
+      } else {
+        std::uninitialized_copy_n(rhs.elm_, length_, elm_);
+      }
+    } else if (ref_count_ != nullptr) {
+      storage_policy::increment(*ref_count_);
     }
   }
   /* move constructor */
-  vector(vector&& rhs) noexcept
-      : length_(std::exchange(rhs.length_, 0)), allocator_(std::exchange(rhs.allocator_, nullptr)), ref_count_(std::exchange(rhs.ref_count_, nullptr)), elm_(std::exchange(rhs.elm_, nullptr)), step_(std::exchange(rhs.step_, 1)) {}
+  vector(vector&& rhs) noexcept : vector() {
+    steal(rhs);
+  }
 
   /* destructor */
   ~vector() noexcept {
+    if (is_inline()) {
+      destroy_elements();
+      return;
+    }
+
     bool need_free = true;
     if (ref_count_ != nullptr) {
-      --*ref_count_;
-      if (*ref_count_ != 0) {
+      if (storage_policy::decrement(*ref_count_) != 0) {
         need_free = false;
       }
     }
     if (need_free && ref_count_ != nullptr && allocator_ != nullptr) {
-      using scalar_type_allocator_type                 = typename std::allocator_traits<std::pmr::polymorphic_allocator<std::byte>>::template rebind_alloc<scalar_type>;
-      using scalar_type_allocator_traits               = std::allocator_traits<scalar_type_allocator_type>;
-      scalar_type_allocator_type scalar_type_allocator = allocator_;
-      if (elm_ != nullptr) {
-        for (std::size_t i = 0; i < length_; ++i) {
-          scalar_type_allocator_traits::destroy(scalar_type_allocator, elm_ + i);
-        }
-        scalar_type_allocator_traits::deallocate(scalar_type_allocator, elm_, length_);
-      }
-
-      using size_t_allocator_type            = typename std::allocator_traits<std::pmr::polymorphic_allocator<std::byte>>::template rebind_alloc<size_t>;
-      using size_t_allocator_traits          = std::allocator_traits<size_t_allocator_type>;
-      size_t_allocator_type size_t_allocator = allocator_;
-      if (ref_count_ != nullptr) {
-        size_t_allocator_traits::destroy(size_t_allocator, ref_count_);
-        size_t_allocator_traits::deallocate(size_t_allocator, ref_count_, 1);
-      }
+      destroy_elements();
+      ref_count_->~counter_type();
+      allocator_->deallocate(ref_count_, block_size(length_), block_alignment);
     }
   }
 
@@ -247,7 +366,44 @@ class vector {
     return *this;
   }
 
+  template<typename E>
+  vector& operator=(const vector_expression<E>& e) {
+    vector(e).swap(*this);
+    return *this;
+  }
+
+  /* evaluates e into the elements this vector already refers to */
+  template<typename E>
+  vector& assign(const vector_expression<E>& e) {
+    static_assert(std::is_same_v<typename E::vector_type, vector>, "vector::assign: expression has a different vector type");
+    const auto& expr = e.self();
+    if (size() != expr.size()) {
+      throw std::invalid_argument("vector::assign: size mismatch");
+    }
+    detach();
+
+    if (expr.aliases(*this)) {
+      copy_elements_from(vector(e, result_allocator()));
+    } else {
+      with_ranges(
+          [&](auto first, auto) {
+            for (std::size_t i = 0; i < size(); ++i) {
+              first[static_cast<std::ptrdiff_t>(i)] = expr[i];
+            }
+          },
+          *this);
+    }
+    return *this;
+  }
+
   void swap(vector& rhs) noexcept {
+    if (is_inline() || rhs.is_inline()) {
+      vector tmp(std::move(rhs));
+      rhs.steal(*this);
+      steal(tmp);
+      return;
+    }
+
     using std::swap;
     swap(length_, rhs.length_);
     swap(allocator_, rhs.allocator_);
@@ -270,6 +426,7 @@ class vector {
     return begin();
   }
   iterator begin() {
+    detach();
     return iterator(elm_, 0, step_);
   }
   const_iterator end() const {
@@ -279,6 +436,7 @@ class vector {
     return end();
   }
   iterator end() {
+    detach();
     return iterator(elm_, static_cast<std::ptrdiff_t>(length_), step_);
   }
 
@@ -286,6 +444,14 @@ class vector {
     return length_;
   }
 
+  std::ptrdiff_t step() const noexcept {
+    return step_;
+  }
+
+  bool is_contiguous() const noexcept {
+    return step_ == 1;
+  }
+
   const scalar_type& operator[](std::size_t idx) const {
     return *(elm_ + static_cast<std::ptrdiff_t>(idx) * step_);
   }
@@ -297,9 +463,11 @@ class vector {
   }
 
   scalar_type& operator[](std::size_t idx) {
+    detach();
     return const_cast<scalar_type&>(const_cast<const vector*>(this)->operator[](idx));
   }
   scalar_type& at(size_t idx) {
+    detach();
     return const_cast<scalar_type&>(const_cast<const vector*>(this)->at(idx));
   }
 
@@ -308,20 +476,23 @@ class vector {
   }
 
   std::optional<std::size_t> ref_count() const {
-    if (ref_count_ != nullptr) {
-      return *ref_count_;
+    if (is_inline()) {
+      return 1;
+    } else if (ref_count_ != nullptr) {
+      return storage_policy::load(*ref_count_);
     } else {
       return std::nullopt;
     }
   }
 
   scalar_type* data() {
+    detach();
     return elm_;
   }
 
   vector clone(std::pmr::memory_resource* allocator) const {
-    vector r(size(), allocator);
-    std::copy(this->begin(), this->end(), r.begin());
+    vector r(size(), default_init, allocator);
+    r.copy_elements_from(*this);
     return r;
   }
 
@@ -335,72 +506,211 @@ class vector {
 
   template<typename F>
   vector map(F f) const {
-    vector r(size(), result_allocator());
-    std::transform(begin(), end(), r.begin(), f);
+    vector r(size(), default_init, result_allocator());
+    if constexpr (kernel_traits_type::is_trivially_copyable) {
+      if (!is_contiguous()) {
+        /* gathering first turns the transform into a contiguous pass */
+        r.copy_elements_from(*this);
+        std::transform(r.elm_, r.elm_ + size(), r.elm_, f);
+        return r;
+      }
+    }
+    with_ranges([&](auto first, auto last) { std::transform(first, last, r.elm_, f); }, *this);
+    return r;
+  }
+
+  template<typename F>
+  vector map(const parallel_policy& policy, F f) const {
+    vector r(size(), default_init, result_allocator());
+    detail::parallel_for(detail::thread_count(policy, size()), size(), [&](std::size_t, std::size_t first, std::size_t last) {
+      with_ranges([&](auto x, auto) { std::transform(x + static_cast<std::ptrdiff_t>(first), x + static_cast<std::ptrdiff_t>(last), r.elm_ + first, f); }, *this);
+    });
     return r;
   }
 
   vector add(const vector& rhs) const {
     validate_same_size(rhs, "vector::add");
-    vector r(size(), result_allocator());
-    for (std::size_t i = 0; i < size(); ++i) {
-      r[i] = (*this)[i] + rhs[i];
-    }
+    vector r(size(), default_init, result_allocator());
+    add_range(rhs, r, 0, size());
+    return r;
+  }
+
+  vector add(const parallel_policy& policy, const vector& rhs) const {
+    validate_same_size(rhs, "vector::add");
+    vector r(size(), default_init, result_allocator());
+    detail::parallel_for(detail::thread_count(policy, size()), size(), [&](std::size_t, std::size_t first, std::size_t last) { add_range(rhs, r, first, last); });
     return r;
   }
 
   vector subtract(const vector& rhs) const {
     validate_same_size(rhs, "vector::subtract");
-    vector r(size(), result_allocator());
-    for (std::size_t i = 0; i < size(); ++i) {
-      r[i] = (*this)[i] - rhs[i];
-    }
+    vector r(size(), default_init, result_allocator());
+    subtract_range(rhs, r, 0, size());
+    return r;
+  }
+
+  vector subtract(const parallel_policy& policy, const vector& rhs) const {
+    validate_same_size(rhs, "vector::subtract");
+    vector r(size(), default_init, result_allocator());
+    detail::parallel_for(detail::thread_count(policy, size()), size(), [&](std::size_t, std::size_t first, std::size_t last) { subtract_range(rhs, r, first, last); });
     return r;
   }
 
   vector scale(scalar_type val) const {
-    return map([val](scalar_type x) { return x * val; });
+    vector r(size(), default_init, result_allocator());
+    scale_range(val, r, 0, size());
+    return r;
   }
 
-  vector operator+(const vector& rhs) const {
+  vector scale(const parallel_policy& policy, scalar_type val) const {
+    vector r(size(), default_init, result_allocator());
+    detail::parallel_for(detail::thread_count(policy, size()), size(), [&](std::size_t, std::size_t first, std::size_t last) { scale_range(val, r, first, last); });
+    return r;
+  }
+
+  /*
+   * The *_into variants write the result into the existing elements of dst,
+   * which may be a strided view, and return dst. They allocate only when dst
+   * partially overlaps an operand; dst may be an operand itself.
+   */
+  template<typename F>
+  vector& map_into(F f, vector& dst) const {
+    validate_same_size(dst, "vector::map_into");
+    dst.detach();
+    if (overlaps_partially(dst)) {
+      return dst.copy_elements_from(map(f));
+    }
+    with_ranges([&](auto first, auto last, auto out) { std::transform(first, last, out, f); }, *this, dst);
+    return dst;
+  }
+
+  vector& add_into(const vector& rhs, vector& dst) const {
+    validate_same_size(rhs, "vector::add_into");
+    validate_same_size(dst, "vector::add_into");
+    dst.detach();
+    if (overlaps_partially(dst) || rhs.overlaps_partially(dst)) {
+      return dst.copy_elements_from(add(rhs));
+    }
+    add_range(rhs, dst, 0, size());
+    return dst;
+  }
+
+  vector& subtract_into(const vector& rhs, vector& dst) const {
+    validate_same_size(rhs, "vector::subtract_into");
+    validate_same_size(dst, "vector::subtract_into");
+    dst.detach();
+    if (overlaps_partially(dst) || rhs.overlaps_partially(dst)) {
+      return dst.copy_elements_from(subtract(rhs));
+    }
+    subtract_range(rhs, dst, 0, size());
+    return dst;
+  }
+
+  vector& scale_into(scalar_type val, vector& dst) const {
+    validate_same_size(dst, "vector::scale_into");
+    dst.detach();
+    if (overlaps_partially(dst)) {
+      return dst.copy_elements_from(scale(val));
+    }
+    scale_range(val, dst, 0, size());
+    return dst;
+  }
+
+  /*
+   * The rvalue overloads compute in place when the left operand is a
+   * temporary that solely owns contiguous storage, so a chain such as
+   * (a + b) * 2 - c allocates only for its first result.
+   */
+  vector operator+(const vector& rhs) const& {
     return add(rhs);
   }
 
-  vector operator-(const vector& rhs) const {
+  vector operator+(const vector& rhs) && {
+    if (!is_reusable()) {
+      return add(rhs);
+    }
+    validate_same_size(rhs, "vector::add");
+    *this += rhs;
+    return std::move(*this);
+  }
+
+  vector operator-(const vector& rhs) const& {
     return subtract(rhs);
   }
 
-  vector operator-() const {
+  vector operator-(const vector& rhs) && {
+    if (!is_reusable()) {
+      return subtract(rhs);
+    }
+    validate_same_size(rhs, "vector::subtract");
+    *this -= rhs;
+    return std::move(*this);
+  }
+
+  vector operator-() const& {
     return map([](scalar_type x) { return -x; });
   }
 
-  vector operator*(scalar_type val) const {
+  vector operator-() && {
+    if (!is_reusable()) {
+      return map([](scalar_type x) { return -x; });
+    }
+    std::transform(elm_, elm_ + size(), elm_, [](const scalar_type& x) { return -x; });
+    return std::move(*this);
+  }
+
+  vector operator*(scalar_type val) const& {
     return scale(val);
   }
 
-  vector operator/(scalar_type val) const {
+  vector operator*(scalar_type val) && {
+    if (!is_reusable()) {
+      return scale(val);
+    }
+    *this *= val;
+    return std::move(*this);
+  }
+
+  vector operator/(scalar_type val) const& {
     return map([val](scalar_type x) { return x / val; });
   }
 
+  vector operator/(scalar_type val) && {
+    if (!is_reusable()) {
+      return map([val](scalar_type x) { return x / val; });
+    }
+    *this /= val;
+    return std::move(*this);
+  }
+
   vector& operator+=(const vector& rhs) {
-    return apply_in_place(rhs, "vector::operator+=", [](scalar_type& lhs, const scalar_type& rhs) { lhs += rhs; });
+    return apply_in_place(
+        rhs, "vector::operator+=", [](scalar_type& lhs, const scalar_type& rhs) { lhs += rhs; },
+        [](scalar_type* lhs, const scalar_type* rhs, std::size_t n) { detail::add(detail::kernel_pointer<scalar_traits>(lhs), detail::kernel_pointer<scalar_traits>(rhs), detail::kernel_pointer<scalar_traits>(lhs), n); });
   }
 
   vector& operator-=(const vector& rhs) {
-    return apply_in_place(rhs, "vector::operator-=", [](scalar_type& lhs, const scalar_type& rhs) { lhs -= rhs; });
+    return apply_in_place(
+        rhs, "vector::operator-=", [](scalar_type& lhs, const scalar_type& rhs) { lhs -= rhs; },
+        [](scalar_type* lhs, const scalar_type* rhs, std::size_t n) { detail::subtract(detail::kernel_pointer<scalar_traits>(lhs), detail::kernel_pointer<scalar_traits>(rhs), detail::kernel_pointer<scalar_traits>(lhs), n); });
   }
 
   vector& operator*=(scalar_type val) {
-    for (auto& elm : *this) {
-      elm *= val;
+    detach();
+    if (is_contiguous()) {
+      detail::scale(detail::kernel_pointer<scalar_traits>(elm_), detail::kernel_value<scalar_traits>(val), detail::kernel_pointer<scalar_traits>(elm_), size());
+      return *this;
+    }
+    if constexpr (kernel_traits_type::has_kernels) {
+      detail::strided_scale(kernel_element(0), step_, detail::kernel_value<scalar_traits>(val), kernel_element(0), step_, size());
+      return *this;
     }
+    with_ranges([val](auto first, auto last) { std::for_each(first, last, [val](scalar_type& x) { x *= val; }); }, *this);
     return *this;
   }
 
   vector& operator/=(scalar_type val) {
-    for (auto& elm : *this) {
-      elm /= val;
-    }
+    with_ranges([val](auto first, auto last) { std::for_each(first, last, [val](scalar_type& x) { x /= val; }); }, *this);
     return *this;
   }
 
@@ -408,22 +718,173 @@ class vector {
     return rhs.scale(lhs);
   }
 
+  friend vector operator*(scalar_type lhs, vector&& rhs) {
+    return std::move(rhs) * lhs;
+  }
+
  private:
-  template<typename F>
-  vector& apply_in_place(const vector& rhs, const char* name, F f) {
-    validate_same_size(rhs, name);
+  template<typename>
+  friend class vector_reference;
+  friend struct detail::vector_access;
+
+  static constexpr bool fits_inline(std::size_t length) noexcept {
+    return inline_capacity > 0 && length <= inline_capacity;
+  }
+
+  bool is_inline() const noexcept {
+    if constexpr (inline_capacity > 0) {
+      return elm_ == this->inline_data();
+    } else {
+      return false;
+    }
+  }
+
+  /* takes over rhs, which is left empty; *this must not own anything */
+  void steal(vector& rhs) noexcept {
+    length_    = std::exchange(rhs.length_, 0);
+    allocator_ = std::exchange(rhs.allocator_, nullptr);
+    ref_count_ = std::exchange(rhs.ref_count_, nullptr);
+    step_      = std::exchange(rhs.step_, 1);
+    if (rhs.is_inline()) {
+      elm_ = this->inline_data();
+      if constexpr (kernel_traits_type::is_trivially_copyable && kernel_traits_type::is_trivially_destructible) {
+        std::memcpy(static_cast<void*>(elm_), static_cast<const void*>(rhs.elm_), length_ * sizeof(scalar_type));
+      } else {
+        std::uninitialized_move_n(rhs.elm_, length_, elm_);
+        std::destroy_n(rhs.elm_, length_);
+      }
+      rhs.elm_ = nullptr;
+    } else {
+      elm_ = std::exchange(rhs.elm_, nullptr);
+    }
+  }
 
-    if (may_share_storage_with(rhs) && !has_identical_element_mapping(rhs)) {
-      const auto rhs_copy = rhs.clone(result_allocator());
-      for (std::size_t i = 0; i < size(); ++i) {
-        f((*this)[i], rhs_copy[i]);
+  /* sets ref_count_ and elm_ for length_ elements, which are left unconstructed */
+  void acquire_storage() {
+    if (fits_inline(length_)) {
+      elm_ = this->inline_data();
+    } else {
+      /* the reference count and the elements share one block: [counter | padding | elements...] */
+      auto* block = static_cast<std::byte*>(allocator_->allocate(block_size(length_), block_alignment));
+      ref_count_  = ::new (block) counter_type(std::size_t(1));
+      elm_        = reinterpret_cast<scalar_type*>(block + elements_offset);
+    }
+  }
+
+  void destroy_elements() noexcept {
+    if constexpr (!kernel_traits_type::is_trivially_destructible) {
+      using scalar_type_allocator_type                 = typename std::allocator_traits<std::pmr::polymorphic_allocator<std::byte>>::template rebind_alloc<scalar_type>;
+      using scalar_type_allocator_traits               = std::allocator_traits<scalar_type_allocator_type>;
+      scalar_type_allocator_type scalar_type_allocator = allocator_;
+      for (std::size_t i = 0; i < length_; ++i) {
+        scalar_type_allocator_traits::destroy(scalar_type_allocator, elm_ + i);
       }
+    }
+  }
+
+  /* r[i] = (*this)[i] + rhs[i] for i in [first, last); r must not partially overlap either operand */
+  void add_range(const vector& rhs, vector& r, std::size_t first, std::size_t last) const {
+    if (is_contiguous() && rhs.is_contiguous() && r.is_contiguous()) {
+      detail::add(detail::kernel_pointer<scalar_traits>(elm_ + first), detail::kernel_pointer<scalar_traits>(rhs.elm_ + first), detail::kernel_pointer<scalar_traits>(r.elm_ + first), last - first);
+    } else if constexpr (kernel_traits_type::has_kernels) {
+      detail::strided_add(kernel_element(first), step_, rhs.kernel_element(first), rhs.step_, r.kernel_element(first), r.step_, last - first);
     } else {
-      for (std::size_t i = 0; i < size(); ++i) {
-        f((*this)[i], rhs[i]);
+      with_ranges(
+          [&](auto x, auto, auto y, auto out) {
+            std::transform(x + static_cast<std::ptrdiff_t>(first), x + static_cast<std::ptrdiff_t>(last), y + static_cast<std::ptrdiff_t>(first), out + static_cast<std::ptrdiff_t>(first), std::plus<>());
+          },
+          *this, rhs, r);
+    }
+  }
+
+  /* r[i] = (*this)[i] - rhs[i] for i in [first, last); r must not partially overlap either operand */
+  void subtract_range(const vector& rhs, vector& r, std::size_t first, std::size_t last) const {
+    if (is_contiguous() && rhs.is_contiguous() && r.is_contiguous()) {
+      detail::subtract(detail::kernel_pointer<scalar_traits>(elm_ + first), detail::kernel_pointer<scalar_traits>(rhs.elm_ + first), detail::kernel_pointer<scalar_traits>(r.elm_ + first), last - first);
+    } else if constexpr (kernel_traits_type::has_kernels) {
+      detail::strided_subtract(kernel_element(first), step_, rhs.kernel_element(first), rhs.step_, r.kernel_element(first), r.step_, last - first);
+    } else {
+      with_ranges(
+          [&](auto x, auto, auto y, auto out) {
+            std::transform(x + static_cast<std::ptrdiff_t>(first), x + static_cast<std::ptrdiff_t>(last), y + static_cast<std::ptrdiff_t>(first), out + static_cast<std::ptrdiff_t>(first), std::minus<>());
+          },
+          *this, rhs, r);
+    }
+  }
+
+  /* r[i] = (*this)[i] * val for i in [first, last); r must not partially overlap *this */
+  void scale_range(scalar_type val, vector& r, std::size_t first, std::size_t last) const {
+    if (is_contiguous() && r.is_contiguous()) {
+      detail::scale(detail::kernel_pointer<scalar_traits>(elm_ + first), detail::kernel_value<scalar_traits>(val), detail::kernel_pointer<scalar_traits>(r.elm_ + first), last - first);
+    } else if constexpr (kernel_traits_type::has_kernels) {
+      detail::strided_scale(kernel_element(first), step_, detail::kernel_value<scalar_traits>(val), r.kernel_element(first), r.step_, last - first);
+    } else {
+      with_ranges(
+          [&](auto x, auto, auto out) {
+            std::transform(x + static_cast<std::ptrdiff_t>(first), x + static_cast<std::ptrdiff_t>(last), out + static_cast<std::ptrdiff_t>(first), [&val](const scalar_type& a) { return a * val; });
+          },
+          *this, r);
+    }
+  }
+
+  /* under a copy-on-write policy, gives this vector its own buffer before it is written to */
+  void detach() {
+    if constexpr (is_copy_on_write<storage_policy>::value) {
+      if (ref_count_ != nullptr && !is_inline() && storage_policy::load(*ref_count_) > 1) {
+        clone(allocator_).swap(*this);
       }
     }
+  }
+
+  /* element i of the view as a pointer to kernel_type; used by the strided kernels, which take the step separately */
+  auto kernel_element(std::size_t i) const noexcept {
+    return detail::kernel_pointer<scalar_traits>(elm_ + static_cast<std::ptrdiff_t>(i) * step_);
+  }
 
+  /* src must not partially overlap *this */
+  vector& copy_elements_from(const vector& src) {
+    if constexpr (kernel_traits_type::is_trivially_copyable) {
+      if (is_contiguous() && src.is_contiguous()) {
+        if (size() != 0) {
+          std::memmove(static_cast<void*>(data()), static_cast<const void*>(src.elm_), size() * sizeof(scalar_type));
+        }
+        return *this;
+      }
+      detach();
+      detail::strided_copy(src.kernel_element(0), src.step_, kernel_element(0), step_, size());
+      return *this;
+    }
+    with_ranges([](auto first, auto last, auto out) { std::copy(first, last, out); }, src, *this);
+    return *this;
+  }
+
+  /* true if no other vector shares the elements, so they may be overwritten */
+  bool is_reusable() const {
+    return is_contiguous() && ref_count() == std::size_t(1);
+  }
+
+  bool overlaps_partially(const vector& rhs) const noexcept {
+    return may_share_storage_with(rhs) && !has_identical_element_mapping(rhs);
+  }
+
+  /* f updates one element; g updates n contiguous elements */
+  template<typename F, typename G>
+  vector& apply_in_place(const vector& rhs, const char* name, F f, G g) {
+    validate_same_size(rhs, name);
+    detach();
+
+    const auto update = [&](const vector& src) {
+      if (is_contiguous() && src.is_contiguous()) {
+        g(elm_, src.elm_, size());
+      } else {
+        with_ranges([&](auto first, auto last, auto x) { std::for_each(first, last, [&](scalar_type& elm) { f(elm, *x++); }); }, *this, src);
+      }
+    };
+    if (overlaps_partially(rhs)) {
+      update(rhs.clone(result_allocator()));
+    } else {
+      update(rhs);
+    }
     return *this;
   }
 
@@ -434,10 +895,14 @@ class vector {
   }
 
   std::pmr::memory_resource* result_allocator() const noexcept {
-    if (allocator_ == nullptr || allocator_ == std::pmr::null_memory_resource()) {
+    return result_allocator(allocator_);
+  }
+
+  static std::pmr::memory_resource* result_allocator(std::pmr::memory_resource* alloc) noexcept {
+    if (alloc == nullptr || alloc == std::pmr::null_memory_resource()) {
       return std::pmr::get_default_resource();
     }
-    return allocator_;
+    return alloc;
   }
 
   bool has_identical_element_mapping(const vector& rhs) const noexcept {
@@ -475,44 +940,352 @@ class vector {
     return !less(lhs_bounds.second, rhs_bounds.first) && !less(rhs_bounds.second, lhs_bounds.first);
   }
 
+  using counter_type = typename storage_policy::counter_type;
+
+  static constexpr std::size_t block_alignment = alignof(counter_type) > alignment ? alignof(counter_type) : alignment;
+  static constexpr std::size_t elements_offset = (sizeof(counter_type) + alignment - 1) / alignment * alignment;
+
+  static std::size_t block_size(std::size_t length) {
+    if (length > (std::numeric_limits<std::size_t>::max() - elements_offset) / sizeof(scalar_type)) {
+      throw std::bad_array_new_length();
+    }
+    return elements_offset + length * sizeof(scalar_type);
+  }
+
   std::size_t length_;
   std::pmr::memory_resource* allocator_;
-  std::size_t* ref_count_;
+  counter_type* ref_count_;
   scalar_type* elm_;
   std::ptrdiff_t step_;
 };
 
-template<typename T, typename scalar_traits>
-typename vector<T, scalar_traits>::scalar_type dot(const vector<T, scalar_traits>& lhs, const vector<T, scalar_traits>& rhs) {
+template<typename T, typename scalar_traits, typename storage_policy>
+vector_reference<vector<T, scalar_traits, storage_policy>> lazy(const vector<T, scalar_traits, storage_policy>& v) noexcept {
+  return vector_reference<vector<T, scalar_traits, storage_policy>>(v);
+}
+
+template<typename E, typename T, typename scalar_traits, typename storage_policy>
+auto operator+(const vector_expression<E>& lhs, const vector<T, scalar_traits, storage_policy>& rhs) {
+  return lhs + lazy(rhs);
+}
+
+template<typename T, typename scalar_traits, typename storage_policy, typename E>
+auto operator+(const vector<T, scalar_traits, storage_policy>& lhs, const vector_expression<E>& rhs) {
+  return lazy(lhs) + rhs;
+}
+
+template<typename E, typename T, typename scalar_traits, typename storage_policy>
+auto operator-(const vector_expression<E>& lhs, const vector<T, scalar_traits, storage_policy>& rhs) {
+  return lhs - lazy(rhs);
+}
+
+template<typename T, typename scalar_traits, typename storage_policy, typename E>
+auto operator-(const vector<T, scalar_traits, storage_policy>& lhs, const vector_expression<E>& rhs) {
+  return lazy(lhs) - rhs;
+}
+
+namespace detail {
+template<typename T>
+struct is_complex : std::false_type {};
+
+template<typename U>
+struct is_complex<std::complex<U>> : std::true_type {};
+
+template<typename T>
+struct real_part {
+  using type = T;
+};
+
+template<typename U>
+struct real_part<std::complex<U>> {
+  using type = U;
+};
+
+/* the reduction kernels read kernel_type elements, widening them to a floating-point accumulator where it is wider */
+template<typename scalar_traits, typename accumulator_type>
+inline constexpr bool has_reduction_kernel_v = kernel_traits<scalar_traits>::has_kernels && std::is_floating_point_v<accumulator_type>;
+
+/* sum of f(i) for i in [0, n), kept in `unroll` independent partial sums */
+template<std::size_t unroll, typename A, typename F>
+A unrolled_sum(std::size_t n, F f) {
+  A acc[unroll] = {};
+  std::size_t i = 0;
+  for (; i + unroll <= n; i += unroll) {
+    for (std::size_t k = 0; k < unroll; ++k) {
+      acc[k] += f(i + k);
+    }
+  }
+  for (; i < n; ++i) {
+    acc[0] += f(i);
+  }
+  for (std::size_t width = 1; width < unroll; width *= 2) {
+    for (std::size_t k = 0; k + width < unroll; k += 2 * width) {
+      acc[k] += acc[k + width];
+    }
+  }
+  return acc[0];
+}
+
+/* dot returns scalar_type, except for storage-only types, which return their accumulator_type */
+template<typename scalar_traits>
+using dot_result_t = std::conditional_t<is_storage_only_v<typename scalar_traits::scalar_type>, accumulator_type_of_t<scalar_traits>, typename scalar_traits::scalar_type>;
+
+/* real type the norms sum in: the real part of accumulator_type, or the type of abs for traits without a wider accumulator */
+template<typename scalar_traits>
+using norm_accumulator_t = std::conditional_t<std::is_same_v<accumulator_type_of_t<scalar_traits>, typename scalar_traits::scalar_type>, decltype(scalar_traits::abs(typename scalar_traits::scalar_type{})),
+                                              typename real_part<accumulator_type_of_t<scalar_traits>>::type>;
+}  // namespace detail
+
+namespace detail {
+/* sum of lhs[i] * conj(rhs[i]) in the traits' accumulator_type, not yet rounded to dot_result_t */
+template<typename T, typename scalar_traits, typename storage_policy>
+accumulator_type_of_t<scalar_traits> accumulate_dot(const vector<T, scalar_traits, storage_policy>& lhs, const vector<T, scalar_traits, storage_policy>& rhs) {
+  using accumulator_type = accumulator_type_of_t<scalar_traits>;
+  if constexpr (has_reduction_kernel_v<scalar_traits, accumulator_type>) {
+    using kernel_type = typename kernel_traits<scalar_traits>::kernel_type;
+    if (lhs.is_contiguous() && rhs.is_contiguous()) {
+      return dot<kernel_type, accumulator_type>(kernel_pointer<scalar_traits>(lhs.data()), kernel_pointer<scalar_traits>(rhs.data()), lhs.size());
+    }
+    return strided_dot<kernel_type, accumulator_type>(kernel_pointer<scalar_traits>(lhs.data()), lhs.step(), kernel_pointer<scalar_traits>(rhs.data()), rhs.step(), lhs.size());
+  }
+
+  return with_ranges(
+      [&](auto x, auto, auto y) {
+        const auto product = [&](std::size_t i) { return static_cast<accumulator_type>(x[i]) * static_cast<accumulator_type>(scalar_traits::conj(y[i])); };
+        return unrolled_sum<kernel_traits<scalar_traits>::unroll, accumulator_type>(lhs.size(), product);
+      },
+      lhs, rhs);
+}
+}  // namespace detail
+
+/* sum of lhs[i] * conj(rhs[i]), accumulated in the traits' accumulator_type and rounded once */
+template<typename T, typename scalar_traits, typename storage_policy>
+detail::dot_result_t<scalar_traits> dot(const vector<T, scalar_traits, storage_policy>& lhs, const vector<T, scalar_traits, storage_policy>& rhs) {
   if (lhs.size() != rhs.size()) {
     throw std::invalid_argument("dot: size mismatch");
   }
+  return static_cast<detail::dot_result_t<scalar_traits>>(detail::accumulate_dot(lhs, rhs));
+}
 
-  typename vector<T, scalar_traits>::scalar_type ret = {};
-  for (std::size_t i = 0; i < lhs.size(); ++i) {
-    ret += lhs[i] * scalar_traits::conj(rhs[i]);
+namespace detail {
+/* non-owning view of v[first, last); the parallel reductions only read through it */
+template<typename T, typename scalar_traits, typename storage_policy>
+vector<T, scalar_traits, storage_policy> segment(const vector<T, scalar_traits, storage_policy>& v, std::size_t first, std::size_t last) {
+  using scalar_type = typename vector<T, scalar_traits, storage_policy>::scalar_type;
+  auto* base        = const_cast<scalar_type*>(v.data()) + static_cast<std::ptrdiff_t>(first) * v.step();
+  return vector<T, scalar_traits, storage_policy>(base, last - first, static_cast<int>(v.step()));
+}
+}  // namespace detail
+
+template<typename T, typename scalar_traits, typename storage_policy>
+detail::dot_result_t<scalar_traits> dot(const parallel_policy& policy, const vector<T, scalar_traits, storage_policy>& lhs, const vector<T, scalar_traits, storage_policy>& rhs) {
+  if (lhs.size() != rhs.size()) {
+    throw std::invalid_argument("dot: size mismatch");
   }
-  return ret;
+
+  using accumulator_type = accumulator_type_of_t<scalar_traits>;
+  const auto chunks      = detail::thread_count(policy, lhs.size());
+  std::vector<accumulator_type> partial(chunks);
+  detail::parallel_for(chunks, lhs.size(), [&](std::size_t k, std::size_t first, std::size_t last) { partial[k] = detail::accumulate_dot(detail::segment(lhs, first, last), detail::segment(rhs, first, last)); });
+
+  accumulator_type ret = {};
+  for (const auto& x : partial) {
+    ret += x;
+  }
+  return static_cast<detail::dot_result_t<scalar_traits>>(ret);
 }
 
-template<typename T, typename scalar_traits>
-typename vector<T, scalar_traits>::scalar_type inner_product(const vector<T, scalar_traits>& lhs, const vector<T, scalar_traits>& rhs) {
+template<typename T, typename scalar_traits, typename storage_policy>
+detail::dot_result_t<scalar_traits> inner_product(const vector<T, scalar_traits, storage_policy>& lhs, const vector<T, scalar_traits, storage_policy>& rhs) {
   return dot(lhs, rhs);
 }
 
-template<typename T, typename scalar_traits, typename scalar>
-auto norm(const vector<T, scalar_traits>& v, scalar p) {
+namespace detail {
+/* LAPACK lassq-style update: keeps scale^2 * ssq equal to the sum of squares seen so far */
+template<typename R>
+void update_scaled_sum_of_squares(R a, R& scale, R& ssq) {
+  if (a != R(0)) {
+    if (scale < a) {
+      ssq   = R(1) + ssq * (scale / a) * (scale / a);
+      scale = a;
+    } else {
+      ssq += (a / scale) * (a / scale);
+    }
+  }
+}
+}  // namespace detail
+
+/* sum of |v[i]|, accumulated in the traits' accumulator_type */
+template<typename T, typename scalar_traits, typename storage_policy>
+auto norm1(const vector<T, scalar_traits, storage_policy>& v) {
+  using scalar_type = typename vector<T, scalar_traits, storage_policy>::scalar_type;
+  using real_type   = decltype(scalar_traits::abs(scalar_type{}));
+  using wide_type   = detail::norm_accumulator_t<scalar_traits>;
+  if constexpr (detail::has_reduction_kernel_v<scalar_traits, wide_type>) {
+    using kernel_type = typename kernel_traits<scalar_traits>::kernel_type;
+    if (v.is_contiguous()) {
+      return static_cast<real_type>(detail::sum_abs<kernel_type, wide_type>(detail::kernel_pointer<scalar_traits>(v.data()), v.size()));
+    }
+    return static_cast<real_type>(detail::strided_sum_abs<kernel_type, wide_type>(detail::kernel_pointer<scalar_traits>(v.data()), v.step(), v.size()));
+  }
+
+  const auto sum = with_ranges(
+      [&](auto x, auto) {
+        const auto magnitude = [&](std::size_t i) { return static_cast<wide_type>(scalar_traits::abs(x[i])); };
+        return detail::unrolled_sum<kernel_traits<scalar_traits>::unroll, wide_type>(v.size(), magnitude);
+      },
+      v);
+  return static_cast<real_type>(sum);
+}
+
+/*
+ * Euclidean norm. The sum of squares is computed directly first, in the
+ * traits' accumulator_type; only if it overflowed or is small enough to have
+ * lost precision to underflow is a second, BLAS nrm2-style scaled pass made.
+ * A zero vector returns 0 without it, so the scaled pass runs only for
+ * inputs that are genuinely huge or tiny.
+ */
+template<typename T, typename scalar_traits, typename storage_policy>
+auto norm2(const vector<T, scalar_traits, storage_policy>& v) {
+  using scalar_type = typename vector<T, scalar_traits, storage_policy>::scalar_type;
+  using real_type   = decltype(scalar_traits::abs(scalar_type{}));
+  using wide_type   = detail::norm_accumulator_t<scalar_traits>;
+
+  wide_type ssq = {};
+  if constexpr (detail::has_reduction_kernel_v<scalar_traits, wide_type>) {
+    using kernel_type = typename kernel_traits<scalar_traits>::kernel_type;
+    const auto* p     = detail::kernel_pointer<scalar_traits>(v.data());
+    if (v.is_contiguous()) {
+      ssq = detail::dot<kernel_type, wide_type>(p, p, v.size());
+    } else {
+      ssq = detail::strided_dot<kernel_type, wide_type>(p, v.step(), p, v.step(), v.size());
+    }
+  } else {
+    ssq = with_ranges(
+        [&](auto x, auto) {
+          const auto square = [&](std::size_t i) {
+            if constexpr (detail::is_complex<scalar_type>::value) {
+              const auto re = static_cast<wide_type>(x[i].real());
+              const auto im = static_cast<wide_type>(x[i].imag());
+              return re * re + im * im;
+            } else {
+              const auto a = static_cast<wide_type>(scalar_traits::abs(x[i]));
+              return a * a;
+            }
+          };
+          return detail::unrolled_sum<kernel_traits<scalar_traits>::unroll, wide_type>(v.size(), square);
+        },
+        v);
+  }
+
+  if constexpr (std::numeric_limits<wide_type>::is_iec559) {
+    constexpr wide_type smallest_exact = std::numeric_limits<wide_type>::min() / std::numeric_limits<wide_type>::epsilon();
+    if (!(std::isfinite(ssq) && ssq >= smallest_exact)) {
+      /* squares of tiny elements also sum to 0, so a zero ssq is only trusted after checking the elements */
+      const auto is_zero = [](const scalar_type& x) { return scalar_traits::abs(x) == real_type{}; };
+      if (ssq == wide_type(0) && with_ranges([&](auto first, auto last) { return std::all_of(first, last, is_zero); }, v)) {
+        return real_type{};
+      }
+      wide_type scale = 0;
+      wide_type sum   = 1;
+      for (std::size_t i = 0; i < v.size(); ++i) {
+        if constexpr (detail::is_complex<scalar_type>::value) {
+          detail::update_scaled_sum_of_squares(static_cast<wide_type>(std::abs(v[i].real())), scale, sum);
+          detail::update_scaled_sum_of_squares(static_cast<wide_type>(std::abs(v[i].imag())), scale, sum);
+        } else {
+          detail::update_scaled_sum_of_squares(static_cast<wide_type>(scalar_traits::abs(v[i])), scale, sum);
+        }
+      }
+      return static_cast<real_type>(scale * std::sqrt(sum));
+    }
+  }
+
+  using std::sqrt;
+  return static_cast<real_type>(sqrt(ssq));
+}
+
+/* max of |v[i]|; NaN if any element is NaN */
+template<typename T, typename scalar_traits, typename storage_policy>
+auto norm_inf(const vector<T, scalar_traits, storage_policy>& v) {
+  using scalar_type = typename vector<T, scalar_traits, storage_policy>::scalar_type;
+  using real_type   = decltype(scalar_traits::abs(scalar_type{}));
+
+  real_type ret = {};
+  with_ranges(
+      [&ret](auto first, auto last) {
+        std::for_each(first, last, [&ret](const scalar_type& x) {
+          const auto a = scalar_traits::abs(x);
+          if constexpr (std::is_integral_v<real_type>) {
+            ret = std::max(ret, a);
+          } else if (a > ret || a != a) {
+            ret = a;
+          }
+        });
+      },
+      v);
+  return ret;
+}
+
+/*
+ * p-norm; p = 1 and infinity are forwarded to norm1 and norm_inf, and p = 2
+ * to norm2 only for floating-point element types, because norm2 of integral
+ * elements returns a truncated integer root.
+ */
+template<typename T, typename scalar_traits, typename storage_policy, typename scalar>
+auto norm(const vector<T, scalar_traits, storage_policy>& v, scalar p) {
+  if (p < scalar(1)) {
+    throw std::range_error("p must be greater than or equal to 1");
+  }
+
+  using scalar_type = typename vector<T, scalar_traits, storage_policy>::scalar_type;
+  using real_type   = decltype(scalar_traits::abs(scalar_type{}));
+  using return_type = decltype(std::pow(scalar_traits::abs(scalar_type{}), p));
+  using sum_type    = std::common_type_t<return_type, detail::norm_accumulator_t<scalar_traits>>;
+  if (p == scalar(1)) {
+    return static_cast<return_type>(norm1(v));
+  } else if (p == scalar(2) && std::is_floating_point_v<real_type>) {
+    return static_cast<return_type>(norm2(v));
+  } else if (std::isinf(p)) {
+    return static_cast<return_type>(norm_inf(v));
+  }
+
+  sum_type ret = {};
+  with_ranges([&](auto first, auto last) { std::for_each(first, last, [&](const scalar_type& x) { ret += std::pow(static_cast<sum_type>(scalar_traits::abs(x)), static_cast<sum_type>(p)); }); }, v);
+
+  return static_cast<return_type>(std::pow(ret, sum_type(1) / static_cast<sum_type>(p)));
+}
+
+template<typename T, typename scalar_traits, typename storage_policy, typename scalar>
+auto norm(const parallel_policy& policy, const vector<T, scalar_traits, storage_policy>& v, scalar p) {
   if (p < scalar(1)) {
     throw std::range_error("p must be greater than or equal to 1");
   }
 
-  using return_type = decltype(std::pow(scalar_traits::abs(typename vector<T, scalar_traits>::scalar_type{}), p));
-  return_type ret   = {};
-  for (std::size_t i = 0; i < v.size(); ++i) {
-    ret += std::pow(scalar_traits::abs(v[i]), p);
+  const auto chunks = detail::thread_count(policy, v.size());
+  if (chunks == 1) {
+    return norm(v, p);
+  }
+
+  using return_type = decltype(norm(v, p));
+  std::vector<return_type> partial(chunks);
+  detail::parallel_for(chunks, v.size(), [&](std::size_t k, std::size_t first, std::size_t last) { partial[k] = norm(detail::segment(v, first, last), p); });
+
+  /* (sum of partial^p)^(1/p), scaled by the largest partial norm so that partial^p cannot overflow */
+  return_type largest = 0;
+  for (const auto& x : partial) {
+    if (x > largest || x != x) {
+      largest = x;
+    }
+  }
+  if (!(largest > return_type(0)) || std::isinf(largest) || std::isinf(p)) {
+    return largest;
   }
 
-  return std::pow(ret, return_type(1) / static_cast<return_type>(p));
+  return_type ret = {};
+  for (const auto& x : partial) {
+    ret += std::pow(x / largest, p);
+  }
+  return largest * std::pow(ret, return_type(1) / static_cast<return_type>(p));
 }
 }  // namespace dicek::math::linalg
 
@@ -26,12 +26,27 @@ SOFTWARE.
 
 #include <cmath>
 #include <complex>
+#include <cstddef>
 #include <type_traits>
 
 namespace dicek::math {
+/*
+ * accumulator_type is what reductions (dot, norms) sum in: float sums in
+ * double, every other type in itself.
+ *
+ * The remaining members are the compile-time properties the kernels
+ * specialize on; traits for user types may omit any of them, see
+ * kernel_traits for the defaults.
+ */
 template<typename T>
 struct scalar_traits {
-  using scalar_type = typename std::remove_reference<typename std::remove_cv<T>::type>::type;
+  using scalar_type      = typename std::remove_reference<typename std::remove_cv<T>::type>::type;
+  using accumulator_type = std::conditional_t<std::is_same_v<scalar_type, float>, double, scalar_type>;
+  using kernel_type      = std::conditional_t<std::is_floating_point_v<scalar_type>, scalar_type, void>;
+
+  static constexpr bool is_trivially_copyable     = std::is_trivially_copyable_v<scalar_type>;
+  static constexpr bool is_trivially_destructible = std::is_trivially_destructible_v<scalar_type>;
+  static constexpr std::size_t unroll             = 4;
 
   static constexpr scalar_type conj(scalar_type val) {
     return val;
@@ -45,7 +60,9 @@ struct scalar_traits {
 
 template<typename U>
 struct scalar_traits<std::complex<U>> {
-  using scalar_type = typename std::remove_reference<typename std::remove_cv<std::complex<U>>::type>::type;
+  using scalar_type      = typename std::remove_reference<typename std::remove_cv<std::complex<U>>::type>::type;
+  using accumulator_type = std::complex<typename scalar_traits<U>::accumulator_type>;
+  using kernel_type      = void;
 
   static constexpr scalar_type conj(scalar_type val) {
     return std::conj(val);
@@ -56,6 +73,89 @@ struct scalar_traits<std::complex<U>> {
     return abs(val);
   }
 };
+
+/* true for types that are only stored, and widened to their accumulator_type for arithmetic (half, bfloat16) */
+template<typename T>
+struct is_storage_only : std::false_type {};
+
+template<typename T>
+inline constexpr bool is_storage_only_v = is_storage_only<T>::value;
+
+namespace detail {
+template<typename traits, typename = void>
+struct declared_kernel_type {
+  using type = std::conditional_t<std::is_floating_point_v<typename traits::scalar_type>, typename traits::scalar_type, void>;
+};
+
+template<typename traits>
+struct declared_kernel_type<traits, std::void_t<typename traits::kernel_type>> {
+  using type = typename traits::kernel_type;
+};
+
+template<typename traits, typename = void>
+struct declared_trivially_copyable : std::is_trivially_copyable<typename traits::scalar_type> {};
+
+template<typename traits>
+struct declared_trivially_copyable<traits, std::void_t<decltype(traits::is_trivially_copyable)>> : std::bool_constant<traits::is_trivially_copyable> {};
+
+template<typename traits, typename = void>
+struct declared_trivially_destructible : std::is_trivially_destructible<typename traits::scalar_type> {};
+
+template<typename traits>
+struct declared_trivially_destructible<traits, std::void_t<decltype(traits::is_trivially_destructible)>> : std::bool_constant<traits::is_trivially_destructible> {};
+
+template<typename traits, typename = void>
+struct declared_unroll : std::integral_constant<std::size_t, 4> {};
+
+template<typename traits>
+struct declared_unroll<traits, std::void_t<decltype(traits::unroll)>> : std::integral_constant<std::size_t, traits::unroll> {};
+}  // namespace detail
+
+/* traits::accumulator_type, or traits::scalar_type for traits that do not declare one */
+template<typename traits, typename = void>
+struct accumulator_type_of {
+  using type = typename traits::scalar_type;
+};
+
+template<typename traits>
+struct accumulator_type_of<traits, std::void_t<typename traits::accumulator_type>> {
+  using type = typename traits::accumulator_type;
+};
+
+template<typename traits>
+using accumulator_type_of_t = typename accumulator_type_of<traits>::type;
+
+/*
+ * What the library may assume about traits::scalar_type, with defaults for
+ * members the traits do not declare:
+ *
+ * - kernel_type (default: scalar_type if it is floating point, otherwise
+ *   void): the type whose kernels process the elements. It must have the
+ *   size, alignment and arithmetic of scalar_type; a strong typedef of
+ *   double can name double here to get the SIMD kernels. void selects
+ *   element-wise loops.
+ * - is_trivially_copyable (default: std::is_trivially_copyable_v): copies
+ *   and clones use memcpy.
+ * - is_trivially_destructible (default: std::is_trivially_destructible_v):
+ *   elements are released without calling their destructors.
+ * - unroll (default: 4): independent partial sums kept by the reductions
+ *   that have no kernel.
+ */
+template<typename traits>
+struct kernel_traits {
+  using scalar_type      = typename traits::scalar_type;
+  using accumulator_type = accumulator_type_of_t<traits>;
+  using kernel_type      = typename detail::declared_kernel_type<traits>::type;
+
+  static constexpr bool has_kernels               = !std::is_void_v<kernel_type>;
+  static constexpr bool is_trivially_copyable     = detail::declared_trivially_copyable<traits>::value;
+  static constexpr bool is_trivially_destructible = detail::declared_trivially_destructible<traits>::value;
+  static constexpr std::size_t unroll             = detail::declared_unroll<traits>::value;
+
+  static_assert(sizeof(std::conditional_t<has_kernels, kernel_type, scalar_type>) == sizeof(scalar_type) && alignof(std::conditional_t<has_kernels, kernel_type, scalar_type>) <= alignof(scalar_type),
+                "kernel_traits: kernel_type must have the size and alignment of scalar_type");
+  static_assert(unroll > 0, "kernel_traits: unroll must be positive");
+};
 }  // namespace dicek::math
 
 #endif /* UUID_DFDD573E_B92E_11E6_AB3C_0800274CD854 */
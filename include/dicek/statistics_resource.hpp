@@ -0,0 +1,139 @@
+/*
+MIT License
+
+Copyright (c) 2022 Daisuke NAGAO
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#ifndef UUID_4D9705C7_CB22_4C7E_BB91_52CCF26D322D
+#define UUID_4D9705C7_CB22_4C7E_BB91_52CCF26D322D
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <limits>
+#include <map>
+#include <memory_resource>
+#include <mutex>
+#include <thread>
+
+namespace dicek {
+struct allocation_statistics {
+  /* histogram[0] counts requests of 0 or 1 byte, histogram[k] those of (2^(k-1), 2^k] bytes */
+  static constexpr std::size_t histogram_bins = std::numeric_limits<std::size_t>::digits + 1;
+
+  std::size_t allocations       = 0;
+  std::size_t deallocations     = 0;
+  std::size_t bytes_allocated   = 0;
+  std::size_t bytes_deallocated = 0;
+  /* highest bytes_in_use() observed */
+  std::size_t peak_bytes = 0;
+  std::array<std::size_t, histogram_bins> histogram{};
+
+  std::size_t bytes_in_use() const noexcept {
+    return bytes_allocated > bytes_deallocated ? bytes_allocated - bytes_deallocated : 0;
+  }
+
+  static std::size_t histogram_bin(std::size_t bytes) noexcept {
+    std::size_t bin = 0;
+    for (std::size_t n = bytes > 0 ? bytes - 1 : 0; n != 0; n >>= 1) {
+      ++bin;
+    }
+    return bin;
+  }
+};
+
+/*
+ * memory_resource that forwards to an upstream resource and records what
+ * passes through it, in total and per calling thread.
+ *
+ * Per-thread figures count the calls a thread made, so memory released on
+ * another thread is counted against the releasing thread. Every call takes
+ * a mutex, so this resource is meant for tests and diagnostics rather than
+ * production allocation paths.
+ */
+class statistics_resource : public std::pmr::memory_resource {
+ public:
+  explicit statistics_resource(std::pmr::memory_resource* upstream = std::pmr::get_default_resource()) noexcept : upstream_(upstream) {}
+
+  statistics_resource(const statistics_resource&) = delete;
+  statistics_resource& operator=(const statistics_resource&) = delete;
+
+  std::pmr::memory_resource* upstream_resource() const noexcept {
+    return upstream_;
+  }
+
+  allocation_statistics statistics() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return total_;
+  }
+
+  /* the calls made by thread `id`; all zero if it made none */
+  allocation_statistics thread_statistics(std::thread::id id = std::this_thread::get_id()) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const auto found = per_thread_.find(id);
+    return found != per_thread_.end() ? found->second : allocation_statistics{};
+  }
+
+  void reset() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    total_ = allocation_statistics{};
+    per_thread_.clear();
+  }
+
+ private:
+  void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+    void* p = upstream_->allocate(bytes, alignment);
+    std::lock_guard<std::mutex> lock(mutex_);
+    record_allocation(total_, bytes);
+    record_allocation(per_thread_[std::this_thread::get_id()], bytes);
+    return p;
+  }
+
+  void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override {
+    upstream_->deallocate(p, bytes, alignment);
+    std::lock_guard<std::mutex> lock(mutex_);
+    record_deallocation(total_, bytes);
+    record_deallocation(per_thread_[std::this_thread::get_id()], bytes);
+  }
+
+  bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+    return this == &other;
+  }
+
+  static void record_allocation(allocation_statistics& stats, std::size_t bytes) noexcept {
+    ++stats.allocations;
+    stats.bytes_allocated += bytes;
+    ++stats.histogram[allocation_statistics::histogram_bin(bytes)];
+    stats.peak_bytes = std::max(stats.peak_bytes, stats.bytes_in_use());
+  }
+
+  static void record_deallocation(allocation_statistics& stats, std::size_t bytes) noexcept {
+    ++stats.deallocations;
+    stats.bytes_deallocated += bytes;
+  }
+
+  std::pmr::memory_resource* upstream_;
+  mutable std::mutex mutex_;
+  allocation_statistics total_;
+  std::map<std::thread::id, allocation_statistics> per_thread_;
+};
+}  // namespace dicek
+
+#endif /* UUID_4D9705C7_CB22_4C7E_BB91_52CCF26D322D */
@@ -0,0 +1,143 @@
+/*
+MIT License
+
+Copyright (c) 2022 Daisuke NAGAO
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstdint>
+#include <dicek/linalg/batch.hpp>
+#include <dicek/statistics_resource.hpp>
+#include <stdexcept>
+
+using dicek::math::linalg::double3;
+using dicek::math::linalg::vector_batch;
+
+template<typename scalar_type>
+using vector = dicek::math::linalg::vector<scalar_type>;
+
+namespace {
+vector_batch<double, 3> make_batch(std::size_t count) {
+  vector_batch<double, 3> b(count);
+  for (std::size_t i = 0; i < count; ++i) {
+    b.set(i, double3(i + 1.0, 2.0 * i, -1.0));
+  }
+  return b;
+}
+}  // namespace
+
+TEST(batchTest, layout_and_views) {
+  dicek::statistics_resource mr;
+  vector_batch<double, 3> b(5, &mr);
+  EXPECT_EQ(5, b.size());
+  EXPECT_EQ(&mr, b.get_allocator());
+  EXPECT_EQ(1, mr.statistics().allocations);
+  EXPECT_EQ(double3(), b[4]);
+
+  b.set(2, double3(1.0, 2.0, 3.0));
+  EXPECT_EQ(double3(1.0, 2.0, 3.0), b[2]);
+
+  for (std::size_t k = 0; k < 3; ++k) {
+    const auto c = b.component(k);
+    EXPECT_TRUE(c.is_contiguous());
+    EXPECT_EQ(5, c.size());
+    EXPECT_EQ(0, reinterpret_cast<std::uintptr_t>(c.data()) % 64);
+    EXPECT_DOUBLE_EQ(k + 1.0, c[2]);
+  }
+
+  auto e = b.element(2);
+  EXPECT_EQ(3, e.size());
+  EXPECT_DOUBLE_EQ(std::sqrt(14.0), norm2(e));
+  e *= 2.0;
+  EXPECT_EQ(double3(2.0, 4.0, 6.0), b[2]);
+
+  // component views work with the dynamic vector's operations
+  auto ys = b.component(1);
+  ys += ys;
+  EXPECT_DOUBLE_EQ(8.0, b[2][1]);
+  EXPECT_DOUBLE_EQ(8.0, norm1(ys));
+
+  EXPECT_THROW(b.component(3), std::out_of_range);
+  EXPECT_THROW(b.element(5), std::out_of_range);
+  EXPECT_EQ(1, mr.statistics().allocations);
+
+  const vector_batch<double, 3> empty;
+  EXPECT_EQ(0, empty.size());
+  EXPECT_EQ(0, empty.component(0).size());
+}
+
+TEST(batchTest, dot_and_norm2) {
+  const auto a = make_batch(37);
+  const auto b = make_batch(37);
+  vector<double> out(37);
+  dot(a, b, out);
+  norm2(a, out);
+  for (std::size_t i = 0; i < 37; ++i) {
+    EXPECT_DOUBLE_EQ(norm2(a[i]), out[i]);
+  }
+  dot(a, b, out);
+  for (std::size_t i = 0; i < 37; ++i) {
+    EXPECT_DOUBLE_EQ(dot(a[i], b[i]), out[i]);
+  }
+
+  vector<double> short_out(36);
+  EXPECT_THROW(dot(a, b, short_out), std::invalid_argument);
+  EXPECT_THROW(norm2(a, short_out), std::invalid_argument);
+}
+
+TEST(batchTest, normalize) {
+  auto a = make_batch(20);
+  a.set(0, double3());
+  normalize(a);
+  EXPECT_EQ(double3(), a[0]);
+  for (std::size_t i = 1; i < a.size(); ++i) {
+    EXPECT_NEAR(1.0, norm2(a[i]), 1e-15);
+  }
+}
+
+TEST(batchTest, add_axpy_and_cross) {
+  auto a       = make_batch(11);
+  const auto b = make_batch(11);
+  vector_batch<double, 3> out(11);
+
+  add(a, b, out);
+  EXPECT_EQ(b[5] * 2.0, out[5]);
+
+  axpy(-2.0, b, out);
+  EXPECT_EQ(double3(), out[5]);
+
+  const vector_batch<double, 3> c(11);
+  EXPECT_THROW(add(a, make_batch(10), out), std::invalid_argument);
+  EXPECT_THROW(axpy(1.0, make_batch(10), out), std::invalid_argument);
+
+  vector_batch<double, 3> ex(2);
+  vector_batch<double, 3> ey(2);
+  ex.set(0, double3(1.0, 0.0, 0.0));
+  ey.set(0, double3(0.0, 1.0, 0.0));
+  ex.set(1, double3(1.0, 2.0, 3.0));
+  ey.set(1, double3(4.0, 5.0, 6.0));
+  // the output may be one of the operands
+  cross(ex, ey, ex);
+  EXPECT_EQ(double3(0.0, 0.0, 1.0), ex[0]);
+  EXPECT_EQ(cross(double3(1.0, 2.0, 3.0), double3(4.0, 5.0, 6.0)), ex[1]);
+  EXPECT_THROW(cross(ex, c, out), std::invalid_argument);
+}
@@ -0,0 +1,238 @@
+/*
+MIT License
+
+Copyright (c) 2022 Daisuke NAGAO
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cmath>
+#include <complex>
+#include <dicek/linalg/blas.hpp>
+#include <dicek/linalg/vector.hpp>
+#include <stdexcept>
+
+template<typename scalar_type>
+using vector = dicek::math::linalg::vector<scalar_type>;
+
+namespace blas = dicek::math::linalg::blas;
+
+TEST(blasTest, axpy) {
+  // contiguous and odd sized, so both the vector kernel and its tail run
+  vector<double> x{1.0, 2.0, 3.0, 4.0, 5.0, 6.0, 7.0, 8.0, 9.0};
+  vector<double> y{9.0, 8.0, 7.0, 6.0, 5.0, 4.0, 3.0, 2.0, 1.0};
+  blas::axpy(2.0, x, y);
+  for (std::size_t i = 0; i < y.size(); ++i) {
+    EXPECT_DOUBLE_EQ(2.0 * (i + 1.0) + (9.0 - i), y[i]);
+  }
+
+  // strided
+  std::array<double, 6> buf{1.0, -1.0, 2.0, -1.0, 3.0, -1.0};
+  vector<double> xs(buf.data(), 3, 2);
+  vector<double> ys{1.0, 1.0, 1.0};
+  blas::axpy(-1.0, xs, ys);
+  EXPECT_DOUBLE_EQ(0.0, ys[0]);
+  EXPECT_DOUBLE_EQ(-1.0, ys[1]);
+  EXPECT_DOUBLE_EQ(-2.0, ys[2]);
+  EXPECT_DOUBLE_EQ(-1.0, buf[1]);
+
+  vector<double> z(2);
+  EXPECT_THROW(blas::axpy(1.0, x, z), std::invalid_argument);
+}
+
+TEST(blasTest, axpy_aliasing) {
+  // identical element mapping: y = a * y + y
+  vector<double> y{1.0, 2.0, 3.0};
+  blas::axpy(1.0, y, y);
+  EXPECT_DOUBLE_EQ(2.0, y[0]);
+  EXPECT_DOUBLE_EQ(4.0, y[1]);
+  EXPECT_DOUBLE_EQ(6.0, y[2]);
+
+  // partial overlap reads x as it was before the call
+  std::array<double, 4> buf{1.0, 2.0, 3.0, 4.0};
+  vector<double> x(buf.data(), 3);
+  vector<double> shifted(buf.data() + 1, 3);
+  blas::axpy(1.0, x, shifted);
+  EXPECT_DOUBLE_EQ(1.0, buf[0]);
+  EXPECT_DOUBLE_EQ(3.0, buf[1]);
+  EXPECT_DOUBLE_EQ(5.0, buf[2]);
+  EXPECT_DOUBLE_EQ(7.0, buf[3]);
+}
+
+TEST(blasTest, axpby) {
+  vector<double> x{1.0, 2.0, 3.0, 4.0, 5.0};
+  vector<double> y{5.0, 4.0, 3.0, 2.0, 1.0};
+  blas::axpby(2.0, x, -1.0, y);
+  for (std::size_t i = 0; i < y.size(); ++i) {
+    EXPECT_DOUBLE_EQ(2.0 * (i + 1.0) - (5.0 - i), y[i]);
+  }
+
+  vector<std::complex<double>> cx{{1.0, 1.0}, {0.0, 2.0}};
+  vector<std::complex<double>> cy{{1.0, 0.0}, {1.0, 0.0}};
+  blas::axpby({0.0, 1.0}, cx, 2.0, cy);
+  EXPECT_EQ(std::complex<double>(1.0, 1.0), cy[0]);
+  EXPECT_EQ(std::complex<double>(0.0, 0.0), cy[1]);
+}
+
+TEST(blasTest, copy) {
+  vector<double> x{1.0, 2.0, 3.0};
+  vector<double> y(3);
+  blas::copy(x, y);
+  EXPECT_NE(x.data(), y.data());
+  for (std::size_t i = 0; i < y.size(); ++i) {
+    EXPECT_DOUBLE_EQ(x[i], y[i]);
+  }
+
+  // reversed view onto the same buffer
+  std::array<double, 3> buf{1.0, 2.0, 3.0};
+  vector<double> forward(buf.data(), 3);
+  vector<double> backward(buf.data() + 2, 3, -1);
+  blas::copy(forward, backward);
+  EXPECT_DOUBLE_EQ(3.0, buf[0]);
+  EXPECT_DOUBLE_EQ(2.0, buf[1]);
+  EXPECT_DOUBLE_EQ(1.0, buf[2]);
+
+  vector<double> z(2);
+  EXPECT_THROW(blas::copy(x, z), std::invalid_argument);
+}
+
+TEST(blasTest, swap) {
+  vector<double> x{1.0, 2.0, 3.0};
+  vector<double> y{4.0, 5.0, 6.0};
+  const double* x_data = x.data();
+  blas::swap(x, y);
+  // elements move, storage does not
+  EXPECT_EQ(x_data, x.data());
+  EXPECT_DOUBLE_EQ(4.0, x[0]);
+  EXPECT_DOUBLE_EQ(6.0, x[2]);
+  EXPECT_DOUBLE_EQ(1.0, y[0]);
+  EXPECT_DOUBLE_EQ(3.0, y[2]);
+
+  std::array<double, 4> buf{1.0, 2.0, 3.0, 4.0};
+  vector<double> evens(buf.data(), 2, 2);
+  vector<double> odds(buf.data() + 1, 2, 2);
+  blas::swap(evens, odds);
+  EXPECT_DOUBLE_EQ(2.0, buf[0]);
+  EXPECT_DOUBLE_EQ(1.0, buf[1]);
+  EXPECT_DOUBLE_EQ(4.0, buf[2]);
+  EXPECT_DOUBLE_EQ(3.0, buf[3]);
+
+  vector<double> z(2);
+  EXPECT_THROW(blas::swap(x, z), std::invalid_argument);
+}
+
+TEST(blasTest, scal) {
+  vector<double> x{1.0, 2.0, 3.0, 4.0, 5.0};
+  blas::scal(3.0, x);
+  for (std::size_t i = 0; i < x.size(); ++i) {
+    EXPECT_DOUBLE_EQ(3.0 * (i + 1.0), x[i]);
+  }
+
+  std::array<double, 4> buf{1.0, 2.0, 3.0, 4.0};
+  vector<double> evens(buf.data(), 2, 2);
+  blas::scal(-1.0, evens);
+  EXPECT_DOUBLE_EQ(-1.0, buf[0]);
+  EXPECT_DOUBLE_EQ(2.0, buf[1]);
+  EXPECT_DOUBLE_EQ(-3.0, buf[2]);
+  EXPECT_DOUBLE_EQ(4.0, buf[3]);
+}
+
+TEST(blasTest, rot) {
+  vector<double> x{1.0, 0.0};
+  vector<double> y{0.0, 1.0};
+  blas::rot(x, y, 0.0, 1.0);
+  EXPECT_DOUBLE_EQ(0.0, x[0]);
+  EXPECT_DOUBLE_EQ(1.0, x[1]);
+  EXPECT_DOUBLE_EQ(-1.0, y[0]);
+  EXPECT_DOUBLE_EQ(0.0, y[1]);
+
+  // complex vectors rotate by real cosine and sine
+  vector<std::complex<double>> cx{{1.0, 2.0}};
+  vector<std::complex<double>> cy{{3.0, 4.0}};
+  blas::rot(cx, cy, 0.5, 0.5);
+  EXPECT_EQ(std::complex<double>(2.0, 3.0), cx[0]);
+  EXPECT_EQ(std::complex<double>(1.0, 1.0), cy[0]);
+
+  // partial overlap: rotation of (buf[0], buf[1]) against (buf[1], buf[2])
+  std::array<double, 3> buf{1.0, 2.0, 3.0};
+  vector<double> lo(buf.data(), 2);
+  vector<double> hi(buf.data() + 1, 2);
+  blas::rot(lo, hi, 1.0, 1.0);
+  EXPECT_DOUBLE_EQ(3.0, buf[0]);
+  EXPECT_DOUBLE_EQ(1.0, buf[1]);
+  EXPECT_DOUBLE_EQ(1.0, buf[2]);
+
+  vector<double> z(1);
+  EXPECT_THROW(blas::rot(x, z, 1.0, 0.0), std::invalid_argument);
+}
+
+/* a strong typedef of double that asks for the double kernels */
+struct length {
+  length(double v = 0.0) : value(v) {}
+  length& operator*=(length rhs) {
+    value *= rhs.value;
+    return *this;
+  }
+  friend length operator+(length lhs, length rhs) {
+    return length(lhs.value + rhs.value);
+  }
+  friend length operator*(length lhs, length rhs) {
+    return length(lhs.value * rhs.value);
+  }
+  double value;
+};
+
+struct length_traits {
+  using scalar_type = length;
+  using kernel_type = double;
+
+  static length conj(length val) {
+    return val;
+  }
+  static double abs(length val) {
+    return std::abs(val.value);
+  }
+};
+
+TEST(blasTest, kernel_type_routes_contiguous_operands_to_its_kernels) {
+  using length_vector = dicek::math::linalg::vector<length, length_traits>;
+
+  length_vector x(9);
+  length_vector y(9);
+  for (std::size_t i = 0; i < x.size(); ++i) {
+    x[i] = length(i + 1.0);
+    y[i] = length(9.0 - i);
+  }
+  blas::axpy(length(2.0), x, y);
+  for (std::size_t i = 0; i < y.size(); ++i) {
+    EXPECT_DOUBLE_EQ(2.0 * (i + 1.0) + (9.0 - i), y[i].value);
+  }
+
+  blas::axpby(length(1.0), x, length(-1.0), y);
+  for (std::size_t i = 0; i < y.size(); ++i) {
+    EXPECT_DOUBLE_EQ(-(i + 1.0) - (9.0 - i), y[i].value);
+  }
+
+  blas::scal(length(0.5), x);
+  for (std::size_t i = 0; i < x.size(); ++i) {
+    EXPECT_DOUBLE_EQ(0.5 * (i + 1.0), x[i].value);
+  }
+}
@@ -0,0 +1,128 @@
+/*
+MIT License
+
+Copyright (c) 2022 Daisuke NAGAO
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#include <gtest/gtest.h>
+
+#include <array>
+#include <complex>
+#include <dicek/linalg/vector.hpp>
+#include <dicek/statistics_resource.hpp>
+
+template<typename scalar_type>
+using vector = dicek::math::linalg::vector<scalar_type>;
+
+using dicek::math::linalg::lazy;
+
+TEST(expressionTest, evaluates_chained_arithmetic) {
+  vector<double> a({1.0, 2.0, 3.0});
+  vector<double> b({10.0, 20.0, 30.0});
+  vector<double> c({3.0, 6.0, 9.0});
+
+  vector<double> r = lazy(a) * 2.0 + b - lazy(c) / 3.0;
+  ASSERT_EQ(3, r.size());
+  EXPECT_DOUBLE_EQ(11.0, r.at(0));
+  EXPECT_DOUBLE_EQ(22.0, r.at(1));
+  EXPECT_DOUBLE_EQ(33.0, r.at(2));
+
+  vector<double> n = -lazy(a) + 0.5 * lazy(b);
+  EXPECT_DOUBLE_EQ(4.0, n.at(0));
+  EXPECT_DOUBLE_EQ(8.0, n.at(1));
+  EXPECT_DOUBLE_EQ(12.0, n.at(2));
+
+  vector<double> m = map(lazy(a) - c, [](double x) { return x * x; });
+  EXPECT_DOUBLE_EQ(4.0, m.at(0));
+  EXPECT_DOUBLE_EQ(16.0, m.at(1));
+  EXPECT_DOUBLE_EQ(36.0, m.at(2));
+}
+
+TEST(expressionTest, evaluation_allocates_only_the_destination) {
+  dicek::statistics_resource mr;
+  vector<double> a({1.0, 2.0, 3.0}, &mr);
+  vector<double> b({10.0, 20.0, 30.0}, &mr);
+  vector<double> c({3.0, 6.0, 9.0}, &mr);
+  const auto before     = mr.statistics().allocations;
+  const auto per_vector = before / 3;
+
+  vector<double> r = lazy(a) * 2.0 + b - lazy(c) / 3.0;
+  EXPECT_EQ(before + per_vector, mr.statistics().allocations);
+  EXPECT_EQ(&mr, r.get_allocator());
+
+  r.assign(lazy(r) * 2.0 - a);
+  EXPECT_EQ(before + per_vector, mr.statistics().allocations);
+  EXPECT_DOUBLE_EQ(21.0, r.at(0));
+  EXPECT_DOUBLE_EQ(42.0, r.at(1));
+  EXPECT_DOUBLE_EQ(63.0, r.at(2));
+}
+
+TEST(expressionTest, assignment_rebinds_and_assign_writes_through) {
+  vector<double> a({1.0, 2.0, 3.0});
+  vector<double> b({10.0, 20.0, 30.0});
+  auto shared = a;
+
+  a = lazy(a) + b;
+  EXPECT_NE(shared.data(), a.data());
+  EXPECT_DOUBLE_EQ(1.0, shared.at(0));
+  EXPECT_DOUBLE_EQ(11.0, a.at(0));
+
+  std::array<double, 6> buf = {1.0, -1.0, 2.0, -1.0, 3.0, -1.0};
+  vector<double> view(buf.data(), 3, 2);
+  view.assign(lazy(b) - view);
+  EXPECT_DOUBLE_EQ(9.0, buf.at(0));
+  EXPECT_DOUBLE_EQ(18.0, buf.at(2));
+  EXPECT_DOUBLE_EQ(27.0, buf.at(4));
+  EXPECT_DOUBLE_EQ(-1.0, buf.at(1));
+}
+
+TEST(expressionTest, assign_preserves_values_for_overlapping_views) {
+  std::array<double, 4> buf = {1.0, 2.0, 3.0, 4.0};
+
+  vector<double> lhs(buf.data() + 1, 3);
+  vector<double> rhs(buf.data(), 3);
+
+  lhs.assign(lazy(lhs) + rhs);
+
+  EXPECT_DOUBLE_EQ(1.0, buf.at(0));
+  EXPECT_DOUBLE_EQ(3.0, buf.at(1));
+  EXPECT_DOUBLE_EQ(5.0, buf.at(2));
+  EXPECT_DOUBLE_EQ(7.0, buf.at(3));
+}
+
+TEST(expressionTest, complex_expression) {
+  using namespace std::literals::complex_literals;
+
+  vector<std::complex<double>> a({1.0 + 1.0i, 2.0 - 1.0i});
+  vector<std::complex<double>> b({1.0i, 1.0});
+
+  vector<std::complex<double>> r = lazy(a) * 1.0i + b;
+  EXPECT_EQ(-1.0 + 2.0i, r.at(0));
+  EXPECT_EQ(2.0 + 2.0i, r.at(1));
+}
+
+TEST(expressionTest, rejects_size_mismatch) {
+  vector<double> v1({1.0, 2.0, 3.0});
+  vector<double> v2({10.0, 20.0});
+
+  EXPECT_THROW(lazy(v1) + v2, std::invalid_argument);
+  EXPECT_THROW(v1 - lazy(v2), std::invalid_argument);
+  EXPECT_THROW(v2.assign(lazy(v1) * 2.0), std::invalid_argument);
+}
@@ -0,0 +1,144 @@
+/*
+MIT License
+
+Copyright (c) 2022 Daisuke NAGAO
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cmath>
+#include <complex>
+#include <cstdint>
+#include <dicek/linalg/fixed_vector.hpp>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+using dicek::math::linalg::double3;
+using dicek::math::linalg::double4;
+using dicek::math::linalg::fixed_vector;
+using dicek::math::linalg::float3;
+using dicek::math::linalg::float4;
+
+namespace {
+constexpr double3 x_axis{1.0, 0.0, 0.0};
+constexpr double3 y_axis{0.0, 1.0, 0.0};
+
+// evaluated at compile time
+static_assert(double3().size() == 3);
+static_assert(double3()[2] == 0.0);
+static_assert(x_axis + y_axis == double3(1.0, 1.0, 0.0));
+static_assert(x_axis - y_axis == double3(1.0, -1.0, 0.0));
+static_assert(-x_axis == double3(-1.0, 0.0, 0.0));
+static_assert(2.0 * x_axis / 4.0 == double3(0.5, 0.0, 0.0));
+static_assert(cross(x_axis, y_axis) == double3(0.0, 0.0, 1.0));
+static_assert(dot(double3(1.0, 2.0, 3.0), double3(4.0, 5.0, 6.0)) == 32.0);
+static_assert(double3(1.0, 2.0, 3.0).map([](double a) { return a * a; }) == double3(1.0, 4.0, 9.0));
+static_assert(x_axis != y_axis);
+
+constexpr double3 accumulate() {
+  double3 v(1, 2, 3);
+  v += double3(1.0, 1.0, 1.0);
+  v -= double3(0.0, 1.0, 2.0);
+  v *= 3.0;
+  v /= 2.0;
+  v[0] = 0.0;
+  return v;
+}
+static_assert(accumulate() == double3(0.0, 3.0, 3.0));
+
+// SIMD-sized packs are aligned to their size; others are unpadded
+static_assert(alignof(float4) == 16 && sizeof(float4) == 16);
+static_assert(alignof(double4) == 32 && sizeof(double4) == 32);
+static_assert(alignof(double3) == alignof(double) && sizeof(double3) == 3 * sizeof(double));
+static_assert(sizeof(float3) == 3 * sizeof(float));
+}  // namespace
+
+TEST(fixed_vectorTest, element_access) {
+  double4 v(1.0, 2.0, 3.0, 4.0);
+  EXPECT_DOUBLE_EQ(3.0, v.at(2));
+  v.at(2) = 5.0;
+  EXPECT_DOUBLE_EQ(5.0, v[2]);
+  EXPECT_THROW(v.at(4), std::out_of_range);
+  EXPECT_EQ(v.data() + 4, v.end());
+  EXPECT_EQ(0, reinterpret_cast<std::uintptr_t>(v.data()) % 32);
+
+  const fixed_vector<int, 2> from_array(std::array<int, 2>{7, 8});
+  EXPECT_EQ(8, from_array[1]);
+}
+
+TEST(fixed_vectorTest, norms) {
+  const double3 v(3.0, -4.0, 0.0);
+  EXPECT_DOUBLE_EQ(7.0, norm1(v));
+  EXPECT_DOUBLE_EQ(5.0, norm2(v));
+  EXPECT_DOUBLE_EQ(4.0, norm_inf(v));
+
+  constexpr double big = std::numeric_limits<double>::max() / 2.0;
+  EXPECT_DOUBLE_EQ(big * std::sqrt(2.0), norm2(fixed_vector<double, 2>(big, big)));
+  constexpr double tiny = std::numeric_limits<double>::denorm_min() * 4.0;
+  EXPECT_DOUBLE_EQ(tiny * std::sqrt(2.0), norm2(fixed_vector<double, 2>(tiny, tiny)));
+  EXPECT_EQ(0.0, norm2(double3()));
+  EXPECT_TRUE(std::isnan(norm_inf(double3(1.0, std::nan(""), 2.0))));
+
+  const float4 f(1.0f, 1.0f, 1.0f, 1.0f);
+  EXPECT_FLOAT_EQ(2.0f, norm2(f));
+}
+
+TEST(fixed_vectorTest, complex_dot_uses_conjugated_rhs) {
+  using complex  = std::complex<double>;
+  using complex3 = fixed_vector<complex, 3>;
+  const complex3 a(complex(1.0, 1.0), 0.0, 0.0);
+  const complex3 b(complex(0.0, 1.0), 0.0, 0.0);
+  EXPECT_EQ(std::complex<double>(1.0, -1.0), dot(a, b));
+  EXPECT_DOUBLE_EQ(std::sqrt(2.0), norm2(a));
+}
+
+TEST(fixed_vectorTest, as_vector_is_a_view) {
+  double3 v(1.0, 2.0, 3.0);
+  auto view = as_vector(v);
+  EXPECT_EQ(v.data(), view.data());
+  EXPECT_EQ(3, view.size());
+  view *= 2.0;
+  EXPECT_EQ(double3(2.0, 4.0, 6.0), v);
+
+  const double3 c(3.0, 4.0, 0.0);
+  EXPECT_DOUBLE_EQ(5.0, norm2(as_vector(c)));
+}
+
+TEST(fixed_vectorTest, component_view_strides_over_an_array) {
+  std::vector<double3> points{{1.0, 2.0, 3.0}, {4.0, 5.0, 6.0}, {7.0, 8.0, 9.0}};
+  auto ys = component_view(points.data(), points.size(), 1);
+  EXPECT_EQ(3, ys.step());
+  EXPECT_DOUBLE_EQ(15.0, norm1(ys));
+
+  ys += ys;
+  EXPECT_DOUBLE_EQ(4.0, points[0][1]);
+  EXPECT_DOUBLE_EQ(16.0, points[2][1]);
+  EXPECT_DOUBLE_EQ(9.0, points[2][2]);
+
+  const std::vector<float4> packed{{1.0f, 0.0f, 0.0f, 2.0f}, {1.0f, 0.0f, 0.0f, 2.0f}};
+  const auto ws = component_view(packed.data(), packed.size(), 3);
+  EXPECT_EQ(4, ws.step());
+  EXPECT_FLOAT_EQ(8.0f, dot(ws, ws));
+
+  EXPECT_EQ(0, component_view(points.data(), 0, 0).size());
+  EXPECT_THROW(component_view(points.data(), points.size(), 3), std::out_of_range);
+}
@@ -0,0 +1,139 @@
+/*
+MIT License
+
+Copyright (c) 2022 Daisuke NAGAO
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstdint>
+#include <dicek/half.hpp>
+#include <dicek/linalg/vector.hpp>
+#include <limits>
+
+using dicek::math::bfloat16;
+using dicek::math::half;
+
+template<typename scalar_type>
+using vector = dicek::math::linalg::vector<scalar_type>;
+
+TEST(halfTest, round_trips_every_finite_half) {
+  for (std::uint32_t bits = 0; bits < 0x10000u; ++bits) {
+    const auto h  = half::from_bits(static_cast<std::uint16_t>(bits));
+    const float f = h;
+    if (std::isnan(f)) {
+      EXPECT_TRUE(std::isnan(static_cast<float>(half(f)))) << bits;
+    } else {
+      EXPECT_EQ(bits, half(f).bits()) << bits;
+    }
+  }
+}
+
+TEST(halfTest, converts_special_values) {
+  EXPECT_EQ(0x3c00u, half(1.0f).bits());
+  EXPECT_EQ(0xc000u, half(-2.0f).bits());
+  EXPECT_EQ(0x7bffu, half(65504.0f).bits());
+  EXPECT_EQ(0x8000u, half(-0.0f).bits());
+  EXPECT_EQ(0x0001u, half(0x1p-24f).bits());
+  EXPECT_EQ(0x0400u, half(0x1p-14f).bits());
+  EXPECT_EQ(0x7c00u, half(std::numeric_limits<float>::infinity()).bits());
+  EXPECT_EQ(0xfc00u, half(-1e6f).bits());
+  EXPECT_TRUE(std::isnan(static_cast<float>(half(std::numeric_limits<float>::quiet_NaN()))));
+  EXPECT_EQ(5.9604644775390625e-8f, static_cast<float>(half::from_bits(0x0001u)));
+}
+
+TEST(halfTest, rounds_to_nearest_even) {
+  /* 1 + 2^-11 is halfway between 1 and the next half; 1 + 3 * 2^-11 is halfway above an odd mantissa */
+  EXPECT_EQ(0x3c00u, half(1.0f + 0x1p-11f).bits());
+  EXPECT_EQ(0x3c02u, half(1.0f + 3 * 0x1p-11f).bits());
+  EXPECT_EQ(0x3c01u, half(1.0f + 0x1p-11f + 0x1p-20f).bits());
+  EXPECT_EQ(0x7bffu, half(65519.0f).bits());
+  EXPECT_EQ(0x7c00u, half(65520.0f).bits());
+  /* subnormals: 2^-25 ties to zero, 3 * 2^-25 ties up to 2 * 2^-24 */
+  EXPECT_EQ(0x0000u, half(0x1p-25f).bits());
+  EXPECT_EQ(0x0002u, half(3 * 0x1p-25f).bits());
+  EXPECT_EQ(0x0400u, half(0x1p-14f - 0x1p-26f).bits());
+}
+
+TEST(halfTest, bfloat16_truncates_float_with_rounding) {
+  EXPECT_EQ(0x3f80u, bfloat16(1.0f).bits());
+  EXPECT_EQ(1.0f, static_cast<float>(bfloat16(1.0f)));
+  EXPECT_EQ(0x3f80u, bfloat16(1.0f + 0x1p-8f).bits());
+  EXPECT_EQ(0x3f82u, bfloat16(1.0f + 3 * 0x1p-8f).bits());
+  EXPECT_EQ(1e30f, static_cast<float>(bfloat16(1e30f)) * (1e30f / static_cast<float>(bfloat16(1e30f))));
+  EXPECT_TRUE(std::isnan(static_cast<float>(bfloat16(std::numeric_limits<float>::quiet_NaN()))));
+  EXPECT_EQ(0x7f80u, bfloat16(std::numeric_limits<float>::infinity()).bits());
+}
+
+TEST(halfTest, traits_accumulate_in_float) {
+  static_assert(std::is_same_v<float, dicek::math::scalar_traits<half>::accumulator_type>);
+  static_assert(std::is_same_v<float, dicek::math::scalar_traits<bfloat16>::accumulator_type>);
+  static_assert(dicek::math::is_storage_only_v<half> && dicek::math::is_storage_only_v<bfloat16>);
+  EXPECT_EQ(2.5f, dicek::math::scalar_traits<half>::abs(half(-2.5f)));
+}
+
+template<typename T>
+class storage_onlyTest : public ::testing::Test {};
+
+using storage_only_types = ::testing::Types<half, bfloat16>;
+TYPED_TEST_SUITE(storage_onlyTest, storage_only_types);
+
+TYPED_TEST(storage_onlyTest, dot_and_norms_widen_to_float) {
+  for (const std::size_t n : {0u, 3u, 31u, 1000u, 4099u}) {
+    vector<TypeParam> x(n);
+    vector<TypeParam> y(n);
+    double expected_dot = 0.0;
+    double expected_ssq = 0.0;
+    double expected_l1  = 0.0;
+    for (std::size_t i = 0; i < n; ++i) {
+      x[i] = static_cast<float>(i % 7) - 3.0f;
+      y[i] = 0.5f + static_cast<float>(i % 3);
+      expected_dot += static_cast<double>(x[i]) * static_cast<double>(y[i]);
+      expected_ssq += static_cast<double>(x[i]) * static_cast<double>(x[i]);
+      expected_l1 += std::abs(static_cast<double>(x[i]));
+    }
+
+    /* the sums exceed what half can represent exactly, so they must not be rounded to half on the way */
+    static_assert(std::is_same_v<float, decltype(dot(x, y))>);
+    EXPECT_FLOAT_EQ(static_cast<float>(expected_dot), dot(x, y)) << n;
+    EXPECT_FLOAT_EQ(static_cast<float>(std::sqrt(expected_ssq)), norm2(x)) << n;
+    EXPECT_FLOAT_EQ(static_cast<float>(expected_l1), norm1(x)) << n;
+    EXPECT_FLOAT_EQ(3.0f * (n > 0), norm_inf(x)) << n;
+
+    if (n > 1) {
+      vector<TypeParam> strided(x.data(), n / 2, 2);
+      double expected_strided = 0.0;
+      for (std::size_t i = 0; i < n / 2; ++i) {
+        expected_strided += static_cast<double>(x[2 * i]) * static_cast<double>(x[2 * i]);
+      }
+      EXPECT_FLOAT_EQ(static_cast<float>(std::sqrt(expected_strided)), norm2(strided)) << n;
+    }
+  }
+}
+
+TYPED_TEST(storage_onlyTest, element_wise_operations_round_to_storage) {
+  vector<TypeParam> x = {TypeParam(1.0f), TypeParam(2.0f), TypeParam(-3.0f)};
+  vector<TypeParam> y = {TypeParam(0.5f), TypeParam(0.25f), TypeParam(4.0f)};
+  const auto z        = x + y * TypeParam(2.0f);
+  EXPECT_EQ(2.0f, static_cast<float>(z[0]));
+  EXPECT_EQ(2.5f, static_cast<float>(z[1]));
+  EXPECT_EQ(5.0f, static_cast<float>(z[2]));
+}
@@ -0,0 +1,125 @@
+/*
+MIT License
+
+Copyright (c) 2022 Daisuke NAGAO
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cstdio>
+#include <dicek/linalg/mapped_file.hpp>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+
+#include <unistd.h>
+
+using dicek::math::linalg::mapped_file;
+
+namespace {
+class mapped_fileTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    path_ = (std::filesystem::temp_directory_path() / ("dicek_mapped_fileTest_" + std::to_string(::getpid()))).string();
+  }
+
+  void TearDown() override {
+    std::remove(path_.c_str());
+  }
+
+  void write(const std::array<double, 4>& values) const {
+    std::ofstream out(path_, std::ios::binary);
+    out.write(reinterpret_cast<const char*>(values.data()), sizeof(values));
+  }
+
+  std::string path_;
+};
+}  // namespace
+
+TEST_F(mapped_fileTest, read_only_view) {
+  write({3.0, 4.0, 0.0, 12.0});
+  mapped_file f(path_);
+  EXPECT_EQ(4 * sizeof(double), f.size());
+  EXPECT_EQ(mapped_file::mode::read_only, f.get_mode());
+  f.advise(mapped_file::access::sequential);
+  f.advise(mapped_file::access::random);
+
+  const auto v = f.view<double>();
+  EXPECT_EQ(4, v.size());
+  EXPECT_EQ(f.data(), v.data());
+  EXPECT_FALSE(v.ref_count());
+  EXPECT_DOUBLE_EQ(13.0, norm2(v));
+
+  const auto head = f.view<double>(0, 2);
+  EXPECT_DOUBLE_EQ(5.0, norm2(head));
+  const auto tail = f.view<double>(2 * sizeof(double));
+  EXPECT_DOUBLE_EQ(12.0, norm_inf(tail));
+  EXPECT_EQ(8, f.view<float>().size());
+
+  EXPECT_THROW(f.mutable_view<double>(), std::logic_error);
+  EXPECT_THROW(f.view<double>(1), std::invalid_argument);
+  EXPECT_THROW(f.view<double>(0, 5), std::out_of_range);
+  EXPECT_THROW(f.view<double>(5 * sizeof(double)), std::out_of_range);
+}
+
+TEST_F(mapped_fileTest, read_write_changes_reach_the_file) {
+  write({1.0, 2.0, 3.0, 4.0});
+  {
+    mapped_file f(path_, mapped_file::mode::read_write);
+    auto v = f.mutable_view<double>();
+    v *= 10.0;
+    f.sync();
+  }
+
+  std::array<double, 4> values{};
+  std::ifstream in(path_, std::ios::binary);
+  in.read(reinterpret_cast<char*>(values.data()), sizeof(values));
+  EXPECT_DOUBLE_EQ(10.0, values[0]);
+  EXPECT_DOUBLE_EQ(40.0, values[3]);
+}
+
+TEST_F(mapped_fileTest, create_and_move) {
+  mapped_file f = mapped_file::create(path_, 3 * sizeof(double));
+  EXPECT_EQ(mapped_file::mode::read_write, f.get_mode());
+  auto v = f.mutable_view<double>();
+  EXPECT_DOUBLE_EQ(0.0, norm1(v));
+  v[2] = 7.0;
+
+  mapped_file g = std::move(f);
+  EXPECT_EQ(nullptr, f.data());
+  EXPECT_EQ(0, f.size());
+  EXPECT_DOUBLE_EQ(7.0, g.view<double>()[2]);
+
+  g = mapped_file(path_);
+  EXPECT_DOUBLE_EQ(7.0, g.view<double>()[2]);
+}
+
+TEST_F(mapped_fileTest, empty_and_missing_files) {
+  mapped_file empty = mapped_file::create(path_, 0);
+  EXPECT_EQ(0, empty.size());
+  EXPECT_EQ(0, empty.view<double>().size());
+  empty.advise(mapped_file::access::will_need);
+  empty.sync();
+
+  EXPECT_THROW(mapped_file(path_ + ".missing"), std::system_error);
+}
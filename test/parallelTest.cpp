@@ -0,0 +1,139 @@
+/*
+MIT License
+
+Copyright (c) 2022 Daisuke NAGAO
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cmath>
+#include <complex>
+#include <dicek/linalg/vector.hpp>
+#include <limits>
+#include <stdexcept>
+
+template<typename scalar_type>
+using vector = dicek::math::linalg::vector<scalar_type>;
+
+using dicek::math::linalg::parallel_policy;
+
+namespace {
+// split even small inputs so the tests exercise the threaded path
+const parallel_policy four_threads{4, 0};
+
+vector<double> iota(std::size_t n, double offset) {
+  vector<double> v(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    v[i] = static_cast<double>(i % 11) + offset;
+  }
+  return v;
+}
+}  // namespace
+
+TEST(parallelTest, element_wise_operations_match_serial_results) {
+  constexpr std::size_t N = 1001;
+  const auto x            = iota(N, -5.0);
+  const auto y            = iota(N, 1.0);
+
+  const auto sum        = x.add(four_threads, y);
+  const auto difference = x.subtract(four_threads, y);
+  const auto scaled     = x.scale(four_threads, 3.0);
+  const auto squared    = x.map(four_threads, [](double v) { return v * v; });
+  for (std::size_t i = 0; i < N; ++i) {
+    EXPECT_EQ(x[i] + y[i], sum[i]);
+    EXPECT_EQ(x[i] - y[i], difference[i]);
+    EXPECT_EQ(x[i] * 3.0, scaled[i]);
+    EXPECT_EQ(x[i] * x[i], squared[i]);
+  }
+}
+
+TEST(parallelTest, reductions_match_serial_results) {
+  constexpr std::size_t N = 1001;
+  const auto x            = iota(N, -5.0);
+  const auto y            = iota(N, 1.0);
+
+  EXPECT_EQ(dot(x, y), dot(four_threads, x, y));
+  EXPECT_DOUBLE_EQ(norm(x, 2.0), norm(four_threads, x, 2.0));
+  EXPECT_DOUBLE_EQ(norm(x, 3.0), norm(four_threads, x, 3.0));
+  EXPECT_DOUBLE_EQ(norm(x, 1.0), norm(four_threads, x, 1.0));
+  EXPECT_DOUBLE_EQ(norm_inf(x), norm(four_threads, x, std::numeric_limits<double>::infinity()));
+}
+
+TEST(parallelTest, dot_rounds_the_combined_partial_sums_once) {
+  // the first chunk sums to 2^24 + 1, which float cannot hold; the second chunk cancels 2^24
+  const dicek::math::linalg::vector<float> x({16777216.0f, 1.0f, -16777216.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f});
+  const dicek::math::linalg::vector<float> ones({1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f});
+
+  EXPECT_EQ(1.0, dot(x, ones));
+  EXPECT_EQ(1.0, dot(four_threads, x, ones));
+}
+
+TEST(parallelTest, strided_and_complex_operands) {
+  std::array<double, 10> buf = {1, -1, 2, -1, 3, -1, 4, -1, 5, -1};
+  vector<double> strided(buf.data() + 8, 5, -2);
+  vector<double> contiguous({10, 20, 30, 40, 50});
+
+  EXPECT_DOUBLE_EQ(350.0, dot(four_threads, strided, contiguous));
+  const auto sum = strided.add(four_threads, contiguous);
+  EXPECT_DOUBLE_EQ(15.0, sum.at(0));
+  EXPECT_DOUBLE_EQ(51.0, sum.at(4));
+
+  using namespace std::literals::complex_literals;
+  vector<std::complex<double>> c({1.0 + 1.0i, 2.0 - 1.0i, 3.0i});
+  EXPECT_EQ(dot(c, c), dot(four_threads, c, c));
+  EXPECT_DOUBLE_EQ(norm(c, 2.0), norm(four_threads, c, 2.0));
+}
+
+TEST(parallelTest, norm_does_not_overflow_when_combining_partial_norms) {
+  // each element squared is finite, but the sum of the squares is not
+  vector<double> v({1e154, 1e154, 1e154, 1e154});
+
+  EXPECT_DOUBLE_EQ(2e154, norm(four_threads, v, 2.0));
+  EXPECT_DOUBLE_EQ(4e154, norm(four_threads, v, 1.0));
+
+  const double big = std::numeric_limits<double>::max() / 4;
+  vector<double> w({big, big, big, big});
+  EXPECT_DOUBLE_EQ(big * 2, norm(four_threads, w, 2.0));
+}
+
+TEST(parallelTest, small_inputs_stay_serial) {
+  const auto x = iota(10, 1.0);
+  EXPECT_EQ(dot(x, x), dot(dicek::math::linalg::par, x, x));
+  EXPECT_EQ(0, vector<double>().add(four_threads, vector<double>()).size());
+}
+
+TEST(parallelTest, rejects_size_mismatch_and_propagates_exceptions) {
+  const auto x = iota(100, 1.0);
+  const auto y = iota(99, 1.0);
+
+  EXPECT_THROW(x.add(four_threads, y), std::invalid_argument);
+  EXPECT_THROW(x.subtract(four_threads, y), std::invalid_argument);
+  EXPECT_THROW(dot(four_threads, x, y), std::invalid_argument);
+  EXPECT_THROW(norm(four_threads, x, 0.5), std::range_error);
+  EXPECT_THROW(x.map(four_threads,
+                     [](double v) {
+                       if (v > 10.0) {
+                         throw std::runtime_error("too large");
+                       }
+                       return v;
+                     }),
+               std::runtime_error);
+}
@@ -58,3 +58,40 @@ TEST(scalar_traitsTest, abs) {
   EXPECT_EQ(dicek::math::scalar_traits<float>::abs(-1.5f), 1.5f);
   EXPECT_EQ(dicek::math::scalar_traits<std::complex<double>>::abs(std::complex<double>(-1.5f, 2.0f)), sqrt(1.5 * 1.5 + 4));
 }
+
+namespace {
+struct fixed_point {
+  int raw;
+};
+
+struct fixed_point_traits {
+  using scalar_type = fixed_point;
+};
+}  // namespace
+
+TEST(scalar_traitsTest, accumulator_type) {
+  static_assert(std::is_same<double, typename dicek::math::scalar_traits<float>::accumulator_type>::value, "float accumulates in double");
+  static_assert(std::is_same<double, typename dicek::math::scalar_traits<double>::accumulator_type>::value, "double accumulates in itself");
+  static_assert(std::is_same<int, typename dicek::math::scalar_traits<int>::accumulator_type>::value, "int accumulates in itself");
+  static_assert(std::is_same<std::complex<double>, typename dicek::math::scalar_traits<std::complex<float>>::accumulator_type>::value, "complex<float> accumulates in complex<double>");
+  static_assert(std::is_same<double, dicek::math::accumulator_type_of_t<dicek::math::scalar_traits<float>>>::value, "declared accumulator");
+  static_assert(std::is_same<fixed_point, dicek::math::accumulator_type_of_t<fixed_point_traits>>::value, "traits without an accumulator fall back to scalar_type");
+  EXPECT_FALSE(dicek::math::is_storage_only_v<float>);
+}
+
+TEST(scalar_traitsTest, kernel_traits_defaults) {
+  using float_traits = dicek::math::kernel_traits<dicek::math::scalar_traits<float>>;
+  static_assert(std::is_same<float, float_traits::kernel_type>::value && float_traits::has_kernels, "float uses the float kernels");
+  static_assert(float_traits::is_trivially_copyable && float_traits::is_trivially_destructible && float_traits::unroll == 4, "float defaults");
+
+  using complex_traits = dicek::math::kernel_traits<dicek::math::scalar_traits<std::complex<double>>>;
+  static_assert(!complex_traits::has_kernels, "interleaved complex runs plain loops");
+
+  using int_traits = dicek::math::kernel_traits<dicek::math::scalar_traits<int>>;
+  static_assert(std::is_void<int_traits::kernel_type>::value, "int has no kernels");
+
+  /* traits declaring only scalar_type get the defaults */
+  using fixed_point_kernel_traits = dicek::math::kernel_traits<fixed_point_traits>;
+  static_assert(!fixed_point_kernel_traits::has_kernels && fixed_point_kernel_traits::is_trivially_copyable && fixed_point_kernel_traits::unroll == 4, "defaults for user traits");
+  SUCCEED();
+}
@@ -0,0 +1,191 @@
+/*
+MIT License
+
+Copyright (c) 2022 Daisuke NAGAO
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <array>
+#include <complex>
+#include <cstdint>
+#include <cstring>
+#include <dicek/linalg/serialization.hpp>
+#include <memory_resource>
+#include <sstream>
+#include <string>
+#include <vector>
+
+template<typename scalar_type>
+using vector = dicek::math::linalg::vector<scalar_type>;
+
+using dicek::math::linalg::deserialize;
+using dicek::math::linalg::deserialize_view;
+using dicek::math::linalg::serialization_error;
+using dicek::math::linalg::serialization_options;
+using dicek::math::linalg::serialize;
+using dicek::math::linalg::serialized_size;
+
+namespace {
+template<typename T>
+std::string to_bytes(const vector<T>& v, const serialization_options& options = {}) {
+  std::ostringstream out;
+  serialize(out, v, options);
+  return out.str();
+}
+
+/* copies bytes into storage aligned like a fresh allocation */
+std::vector<std::max_align_t> aligned_copy(const std::string& bytes) {
+  std::vector<std::max_align_t> buf((bytes.size() + sizeof(std::max_align_t) - 1) / sizeof(std::max_align_t));
+  std::memcpy(buf.data(), bytes.data(), bytes.size());
+  return buf;
+}
+}  // namespace
+
+TEST(serializationTest, header_layout) {
+  const vector<double> v{1.0, 2.0, 3.0};
+  const auto bytes = to_bytes(v);
+  EXPECT_EQ(serialized_size(v), bytes.size());
+  EXPECT_EQ(64 + 3 * sizeof(double), bytes.size());
+  EXPECT_EQ("DCKV", bytes.substr(0, 4));
+  EXPECT_EQ(1, bytes[4]);
+  EXPECT_EQ(2, bytes[6]);
+  EXPECT_EQ(3, bytes[8]);
+  EXPECT_EQ(64, static_cast<unsigned char>(bytes[16]));
+
+  serialization_options page;
+  page.alignment = 4096;
+  EXPECT_EQ(4096 + 3 * sizeof(double), to_bytes(v, page).size());
+  serialization_options bad;
+  bad.alignment = 48;
+  EXPECT_THROW(to_bytes(v, bad), std::invalid_argument);
+}
+
+TEST(serializationTest, round_trip) {
+  const vector<float> f{1.5f, -2.0f, 3.25f};
+  std::istringstream fin(to_bytes(f));
+  const auto f2 = deserialize<float>(fin);
+  ASSERT_EQ(3, f2.size());
+  EXPECT_FLOAT_EQ(3.25f, f2[2]);
+
+  const vector<std::complex<double>> c{{1.0, 2.0}, {3.0, 4.0}};
+  std::istringstream cin(to_bytes(c));
+  EXPECT_EQ(std::complex<double>(3.0, 4.0), deserialize<std::complex<double>>(cin)[1]);
+
+  const vector<std::int64_t> i{1, -2, 1LL << 40};
+  std::istringstream iin(to_bytes(i));
+  EXPECT_EQ(1LL << 40, deserialize<std::int64_t>(iin)[2]);
+
+  const vector<double> empty;
+  std::istringstream ein(to_bytes(empty));
+  EXPECT_EQ(0, deserialize<double>(ein).size());
+
+  // several vectors in one stream
+  std::stringstream stream;
+  serialize(stream, vector<double>{1.0});
+  serialize(stream, vector<double>{2.0, 3.0});
+  EXPECT_DOUBLE_EQ(1.0, deserialize<double>(stream)[0]);
+  EXPECT_DOUBLE_EQ(3.0, deserialize<double>(stream)[1]);
+}
+
+TEST(serializationTest, strided_vectors_are_written_in_element_order) {
+  std::array<double, 2000> buf{};
+  for (std::size_t i = 0; i < buf.size(); ++i) {
+    buf[i] = static_cast<double>(i);
+  }
+  const vector<double> reversed(buf.data() + buf.size() - 1, 1000, -2);
+  std::istringstream in(to_bytes(reversed));
+  const auto r = deserialize<double>(in);
+  ASSERT_EQ(1000, r.size());
+  for (std::size_t i = 0; i < r.size(); ++i) {
+    EXPECT_DOUBLE_EQ(reversed[i], r[i]);
+  }
+
+  // the checksum does not depend on the layout
+  EXPECT_EQ(to_bytes(reversed), to_bytes(reversed.clone(std::pmr::get_default_resource())));
+}
+
+TEST(serializationTest, rejects_corrupt_input) {
+  const vector<double> v{1.0, 2.0, 3.0};
+  const auto bytes = to_bytes(v);
+
+  auto corrupt = bytes;
+  corrupt[bytes.size() - 1] ^= 1;
+  std::istringstream corrupt_in(corrupt);
+  EXPECT_THROW(deserialize<double>(corrupt_in), serialization_error);
+
+  serialization_options unchecked;
+  unchecked.checksum   = false;
+  auto unchecked_bytes = to_bytes(v, unchecked);
+  unchecked_bytes[unchecked_bytes.size() - 1] ^= 1;
+  std::istringstream unchecked_in(unchecked_bytes);
+  EXPECT_NO_THROW(deserialize<double>(unchecked_in));
+
+  std::istringstream wrong_type(bytes);
+  EXPECT_THROW(deserialize<float>(wrong_type), serialization_error);
+
+  std::istringstream truncated(bytes.substr(0, bytes.size() - 1));
+  EXPECT_THROW(deserialize<double>(truncated), serialization_error);
+
+  std::istringstream short_header(bytes.substr(0, 16));
+  EXPECT_THROW(deserialize<double>(short_header), serialization_error);
+
+  auto bad_magic = bytes;
+  bad_magic[0]   = 'X';
+  std::istringstream bad_magic_in(bad_magic);
+  EXPECT_THROW(deserialize<double>(bad_magic_in), serialization_error);
+
+  auto future = bytes;
+  future[4]   = 2;
+  std::istringstream future_in(future);
+  EXPECT_THROW(deserialize<double>(future_in), serialization_error);
+}
+
+TEST(serializationTest, foreign_byte_order_is_converted) {
+  const vector<std::complex<float>> v{{1.0f, -2.0f}};
+  auto bytes = to_bytes(v);
+  // rewrite the payload in the other byte order and flip the flag
+  std::reverse(bytes.begin() + 64, bytes.begin() + 68);
+  std::reverse(bytes.begin() + 68, bytes.begin() + 72);
+  bytes[7] ^= 1;
+  bytes[7] &= ~2;
+
+  std::istringstream in(bytes);
+  EXPECT_EQ(std::complex<float>(1.0f, -2.0f), deserialize<std::complex<float>>(in)[0]);
+
+  const auto buf = aligned_copy(bytes);
+  EXPECT_THROW(deserialize_view<std::complex<float>>(buf.data(), bytes.size()), serialization_error);
+}
+
+TEST(serializationTest, deserialize_view_does_not_copy) {
+  const vector<double> v{1.0, 2.0, 3.0};
+  const auto bytes = to_bytes(v);
+  const auto buf   = aligned_copy(bytes);
+
+  const auto view = deserialize_view<double>(buf.data(), bytes.size());
+  EXPECT_EQ(reinterpret_cast<const std::byte*>(buf.data()) + 64, reinterpret_cast<const std::byte*>(view.data()));
+  EXPECT_FALSE(view.ref_count());
+  EXPECT_DOUBLE_EQ(14.0, dot(view, view));
+
+  EXPECT_THROW(deserialize_view<double>(buf.data(), bytes.size() - 1), serialization_error);
+  EXPECT_THROW(deserialize_view<double>(buf.data(), 8), serialization_error);
+  EXPECT_THROW(deserialize_view<float>(buf.data(), bytes.size()), serialization_error);
+}
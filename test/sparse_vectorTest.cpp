@@ -0,0 +1,233 @@
+/*
+MIT License
+
+Copyright (c) 2022 Daisuke NAGAO
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <complex>
+#include <cstdint>
+#include <dicek/linalg/sparse_vector.hpp>
+#include <dicek/statistics_resource.hpp>
+#include <stdexcept>
+#include <vector>
+
+using dicek::math::linalg::sparse_vector;
+
+template<typename scalar_type>
+using vector = dicek::math::linalg::vector<scalar_type>;
+
+namespace {
+/* every seventh element of a dimension-n vector set to its index + 1 */
+template<typename T>
+sparse_vector<T> make_sparse(std::size_t n, std::size_t stride = 7, std::size_t offset = 0) {
+  sparse_vector<T> s(n);
+  for (std::size_t i = offset; i < n; i += stride) {
+    s.push_back(i, static_cast<T>(i + 1));
+  }
+  return s;
+}
+
+template<typename T>
+vector<T> make_dense(std::size_t n) {
+  vector<T> v(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    v[i] = static_cast<T>(1) / static_cast<T>(i % 5 + 1);
+  }
+  return v;
+}
+}  // namespace
+
+TEST(sparse_vectorTest, stores_sorted_entries) {
+  sparse_vector<double> s(10, {{1, 2.0}, {4, -1.0}, {9, 3.0}});
+  EXPECT_EQ(10u, s.size());
+  EXPECT_EQ(3u, s.nnz());
+  EXPECT_EQ(2.0, s[1]);
+  EXPECT_EQ(0.0, s[2]);
+  EXPECT_EQ(3.0, s.at(9));
+  EXPECT_THROW(s.at(10), std::out_of_range);
+
+  EXPECT_THROW(s.push_back(9, 1.0), std::invalid_argument);
+  EXPECT_THROW(s.push_back(10, 1.0), std::out_of_range);
+  EXPECT_THROW(s.set(10, 1.0), std::out_of_range);
+
+  s.set(4, 5.0);
+  s.set(0, 7.0);
+  s.set(6, 8.0);
+  ASSERT_EQ(5u, s.nnz());
+  const std::uint32_t expected[] = {0, 1, 4, 6, 9};
+  for (std::size_t k = 0; k < s.nnz(); ++k) {
+    EXPECT_EQ(expected[k], s.indices()[k]);
+  }
+  EXPECT_EQ(5.0, s[4]);
+  EXPECT_EQ(8.0, s[6]);
+
+  s.clear();
+  EXPECT_EQ(0u, s.nnz());
+  EXPECT_EQ(10u, s.size());
+  EXPECT_EQ(0.0, s[1]);
+}
+
+TEST(sparse_vectorTest, converts_from_and_to_dense) {
+  vector<double> v = {0.0, 1.5, 0.0, 0.0, -2.0, 0.0};
+  const auto s     = sparse_vector<double>::from_dense(v);
+  EXPECT_EQ(6u, s.size());
+  ASSERT_EQ(2u, s.nnz());
+  EXPECT_EQ(1u, s.indices()[0]);
+  EXPECT_EQ(4u, s.indices()[1]);
+
+  const auto d = s.to_dense();
+  ASSERT_EQ(v.size(), d.size());
+  for (std::size_t i = 0; i < v.size(); ++i) {
+    EXPECT_EQ(v[i], d[i]);
+  }
+}
+
+TEST(sparse_vectorTest, allocates_from_its_resource) {
+  dicek::statistics_resource stats;
+  sparse_vector<double> s(100, &stats);
+  s.push_back(3, 1.0);
+  EXPECT_EQ(&stats, s.get_allocator());
+  EXPECT_EQ(2u, stats.statistics().allocations);
+
+  const auto d = s.to_dense();
+  EXPECT_EQ(3u, stats.statistics().allocations);
+  EXPECT_EQ(1.0, d[3]);
+}
+
+TEST(sparse_vectorTest, sparse_dense_dot) {
+  for (const std::size_t n : {0u, 5u, 64u, 1000u, 4099u}) {
+    const auto s    = make_sparse<double>(n);
+    const auto v    = make_dense<double>(n);
+    double expected = 0.0;
+    for (std::size_t i = 0; i < n; ++i) {
+      expected += s[i] * v[i];
+    }
+    EXPECT_NEAR(expected, dot(s, v), 1e-9 * (1.0 + std::abs(expected))) << n;
+    EXPECT_NEAR(expected, dot(v, s), 1e-9 * (1.0 + std::abs(expected))) << n;
+
+    const auto sf   = make_sparse<float>(n);
+    const auto vf   = make_dense<float>(n);
+    float expectedf = 0.0f;
+    for (std::size_t i = 0; i < n; ++i) {
+      expectedf += sf[i] * vf[i];
+    }
+    EXPECT_NEAR(expectedf, dot(sf, vf), 1e-4f * (1.0f + std::abs(expectedf))) << n;
+  }
+}
+
+TEST(sparse_vectorTest, sparse_dense_dot_on_strided_view) {
+  const std::size_t n = 300;
+  auto base           = make_dense<double>(2 * n);
+  vector<double> v(base.data() + 2 * n - 1, n, -2);
+  const auto s = make_sparse<double>(n, 3);
+
+  double expected = 0.0;
+  for (std::size_t i = 0; i < n; ++i) {
+    expected += s[i] * v[i];
+  }
+  EXPECT_NEAR(expected, dot(s, v), 1e-9 * expected);
+  EXPECT_THROW(dot(s, make_dense<double>(n + 1)), std::invalid_argument);
+}
+
+TEST(sparse_vectorTest, float_dot_accumulates_in_double_on_every_layout) {
+  // 2^24 plus 64 ones: float partial sums stall at 2^24, double ones do not
+  const std::size_t n = 65;
+  sparse_vector<float> s(n);
+  s.push_back(0, 16777216.0f);
+  for (std::size_t i = 1; i < n; ++i) {
+    s.push_back(i, 1.0f);
+  }
+
+  std::vector<float> ones(2 * n, 1.0f);
+  const vector<float> contiguous(ones.data(), n);
+  const vector<float> strided(ones.data(), n, 2);
+  EXPECT_EQ(16777280.0, dot(s, contiguous));
+  EXPECT_EQ(16777280.0, dot(s, strided));
+  EXPECT_EQ(16777280.0, dot(contiguous, s));
+  EXPECT_EQ(16777280.0, dot(strided, s));
+}
+
+TEST(sparse_vectorTest, complex_dot_conjugates_rhs) {
+  using c = std::complex<double>;
+  sparse_vector<c> s(4, {{1, c(1.0, 2.0)}, {3, c(0.0, 1.0)}});
+  vector<c> v = {c(9.0, 9.0), c(3.0, -1.0), c(5.0, 5.0), c(2.0, 2.0)};
+
+  const c expected_sd = c(1.0, 2.0) * std::conj(c(3.0, -1.0)) + c(0.0, 1.0) * std::conj(c(2.0, 2.0));
+  const c expected_ds = c(3.0, -1.0) * std::conj(c(1.0, 2.0)) + c(2.0, 2.0) * std::conj(c(0.0, 1.0));
+  EXPECT_EQ(expected_sd, dot(s, v));
+  EXPECT_EQ(expected_ds, dot(v, s));
+}
+
+TEST(sparse_vectorTest, sparse_sparse_dot) {
+  const std::size_t n = 10000;
+  /* balanced sizes take the merge, a short lhs or rhs the binary search */
+  const auto a = make_sparse<double>(n, 3);
+  const auto b = make_sparse<double>(n, 5, 1);
+  const auto c = make_sparse<double>(n, 997, 2);
+  for (const auto* lhs : {&a, &b, &c}) {
+    for (const auto* rhs : {&a, &b, &c}) {
+      double expected = 0.0;
+      for (std::size_t i = 0; i < n; ++i) {
+        expected += (*lhs)[i] * (*rhs)[i];
+      }
+      EXPECT_DOUBLE_EQ(expected, dot(*lhs, *rhs));
+    }
+  }
+  EXPECT_EQ(0.0, dot(sparse_vector<double>(n), a));
+  EXPECT_THROW(dot(a, sparse_vector<double>(n + 1)), std::invalid_argument);
+}
+
+TEST(sparse_vectorTest, axpy_into_dense) {
+  for (const std::size_t n : {0u, 9u, 130u, 2049u}) {
+    const auto s  = make_sparse<double>(n, 2);
+    auto y        = make_dense<double>(n);
+    const auto y0 = y.clone();
+    axpy(0.5, s, y);
+    for (std::size_t i = 0; i < n; ++i) {
+      EXPECT_DOUBLE_EQ(y0[i] + 0.5 * s[i], y[i]) << i;
+    }
+
+    const auto sf  = make_sparse<float>(n, 2);
+    auto yf        = make_dense<float>(n);
+    const auto yf0 = yf.clone();
+    axpy(-2.0f, sf, yf);
+    for (std::size_t i = 0; i < n; ++i) {
+      EXPECT_FLOAT_EQ(yf0[i] - 2.0f * sf[i], yf[i]) << i;
+    }
+  }
+
+  auto base = make_dense<double>(20);
+  vector<double> column(base.data(), 10, 2);
+  axpy(1.0, sparse_vector<double>(10, {{4, 1.0}}), column);
+  EXPECT_DOUBLE_EQ(1.0 / 4.0 + 1.0, base[8]);
+  EXPECT_THROW(axpy(1.0, sparse_vector<double>(11), column), std::invalid_argument);
+}
+
+TEST(sparse_vectorTest, norms_of_stored_values) {
+  sparse_vector<double> s(1000, {{10, 3.0}, {500, -4.0}});
+  EXPECT_DOUBLE_EQ(7.0, norm1(s));
+  EXPECT_DOUBLE_EQ(5.0, norm2(s));
+  EXPECT_DOUBLE_EQ(4.0, norm_inf(s));
+  EXPECT_NEAR(std::cbrt(91.0), norm(s, 3.0), 1e-12);
+  EXPECT_EQ(0.0, norm2(sparse_vector<double>(3)));
+}
@@ -0,0 +1,176 @@
+/*
+MIT License
+
+Copyright (c) 2022 Daisuke NAGAO
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <complex>
+#include <cstdint>
+#include <dicek/linalg/split_complex.hpp>
+#include <limits>
+#include <stdexcept>
+
+using dicek::math::linalg::split_complex_vector;
+
+template<typename scalar_type>
+using vector = dicek::math::linalg::vector<scalar_type>;
+
+namespace {
+template<typename U>
+vector<std::complex<U>> make_interleaved(std::size_t n, U phase) {
+  vector<std::complex<U>> v(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    v[i] = std::complex<U>(static_cast<U>(i % 7) - 3, static_cast<U>(i % 5) * phase);
+  }
+  return v;
+}
+}  // namespace
+
+template<typename T>
+class split_complexTest : public ::testing::Test {};
+
+using real_types = ::testing::Types<float, double>;
+TYPED_TEST_SUITE(split_complexTest, real_types);
+
+TYPED_TEST(split_complexTest, converts_to_and_from_interleaved) {
+  using U      = TypeParam;
+  const auto v = make_interleaved<U>(37, U(0.5));
+  const auto s = split_complex_vector<U>::from_interleaved(v);
+  ASSERT_EQ(v.size(), s.size());
+  EXPECT_TRUE(s.is_contiguous());
+  EXPECT_EQ(0u, reinterpret_cast<std::uintptr_t>(s.real().data()) % 64);
+  EXPECT_EQ(0u, reinterpret_cast<std::uintptr_t>(s.imag().data()) % 64);
+  for (std::size_t i = 0; i < v.size(); ++i) {
+    EXPECT_EQ(v[i], s[i]);
+    EXPECT_EQ(v[i].real(), s.real()[i]);
+    EXPECT_EQ(v[i].imag(), s.imag()[i]);
+  }
+
+  const auto back = s.to_interleaved();
+  for (std::size_t i = 0; i < v.size(); ++i) {
+    EXPECT_EQ(v[i], back[i]);
+  }
+}
+
+TYPED_TEST(split_complexTest, dot_matches_interleaved_dot) {
+  using U = TypeParam;
+  for (const std::size_t n : {0u, 1u, 7u, 64u, 1001u}) {
+    const auto a = make_interleaved<U>(n, U(1));
+    const auto b = make_interleaved<U>(n, U(-2));
+    const auto x = split_complex_vector<U>::from_interleaved(a);
+    const auto y = split_complex_vector<U>::from_interleaved(b);
+
+    const auto expected = dot(a, b);
+    const auto actual   = dot(x, y);
+    const U tolerance   = std::numeric_limits<U>::epsilon() * 16 * static_cast<U>(n + 1) * 16;
+    EXPECT_NEAR(expected.real(), actual.real(), tolerance) << n;
+    EXPECT_NEAR(expected.imag(), actual.imag(), tolerance) << n;
+  }
+  EXPECT_THROW(dot(split_complex_vector<U>(2), split_complex_vector<U>(3)), std::invalid_argument);
+}
+
+TYPED_TEST(split_complexTest, strided_views_of_interleaved_storage) {
+  using U = TypeParam;
+  auto a  = make_interleaved<U>(50, U(1));
+  auto b  = make_interleaved<U>(50, U(3));
+  split_complex_vector<U> x(real_view(a), imag_view(a));
+  split_complex_vector<U> y(real_view(b), imag_view(b));
+  EXPECT_FALSE(x.is_contiguous());
+
+  const auto expected = dot(a, b);
+  const auto actual   = dot(x, y);
+  EXPECT_NEAR(expected.real(), actual.real(), 1e-3);
+  EXPECT_NEAR(expected.imag(), actual.imag(), 1e-3);
+
+  /* writes through the split view land in the interleaved vector */
+  const std::complex<U> alpha(U(0.5), U(-1));
+  const auto b0 = b.clone();
+  axpy(alpha, x, y);
+  for (std::size_t i = 0; i < b.size(); ++i) {
+    const auto z = b0[i] + alpha * a[i];
+    EXPECT_NEAR(z.real(), b[i].real(), 1e-5);
+    EXPECT_NEAR(z.imag(), b[i].imag(), 1e-5);
+  }
+
+  /* norm2 of a real part as an ordinary strided vector */
+  U ssq = 0;
+  for (std::size_t i = 0; i < a.size(); ++i) {
+    ssq += a[i].real() * a[i].real();
+  }
+  EXPECT_NEAR(std::sqrt(ssq), norm2(real_view(a)), 1e-4);
+}
+
+TYPED_TEST(split_complexTest, axpy_and_scale) {
+  using U = TypeParam;
+  for (const std::size_t n : {0u, 5u, 33u, 1030u}) {
+    const auto a = make_interleaved<U>(n, U(1));
+    const auto b = make_interleaved<U>(n, U(2));
+    const auto x = split_complex_vector<U>::from_interleaved(a);
+    auto y       = split_complex_vector<U>::from_interleaved(b);
+
+    const std::complex<U> alpha(U(2), U(-0.5));
+    axpy(alpha, x, y);
+    const auto scaled = x.scale(alpha);
+    auto in_place     = x.clone();
+    in_place *= alpha;
+    for (std::size_t i = 0; i < n; ++i) {
+      const auto expected_axpy  = b[i] + alpha * a[i];
+      const auto expected_scale = alpha * a[i];
+      EXPECT_NEAR(expected_axpy.real(), y[i].real(), 1e-5) << i;
+      EXPECT_NEAR(expected_axpy.imag(), y[i].imag(), 1e-5) << i;
+      EXPECT_NEAR(expected_scale.real(), scaled[i].real(), 1e-5) << i;
+      EXPECT_NEAR(expected_scale.imag(), scaled[i].imag(), 1e-5) << i;
+      EXPECT_EQ(scaled[i], in_place[i]) << i;
+    }
+  }
+}
+
+TYPED_TEST(split_complexTest, axpy_with_swapped_parts_of_the_destination) {
+  using U = TypeParam;
+  auto y  = split_complex_vector<U>::from_interleaved(make_interleaved<U>(40, U(1)));
+  /* x = i * conj(y) shares y's storage with its parts swapped */
+  const split_complex_vector<U> x(y.imag(), y.real());
+  const auto y0 = y.clone();
+  axpy(std::complex<U>(1), x, y);
+  for (std::size_t i = 0; i < y.size(); ++i) {
+    EXPECT_EQ(y0[i].real() + y0[i].imag(), y[i].real());
+    EXPECT_EQ(y0[i].imag() + y0[i].real(), y[i].imag());
+  }
+}
+
+TYPED_TEST(split_complexTest, norms) {
+  using U = TypeParam;
+  split_complex_vector<U> v(3);
+  v.set(0, std::complex<U>(3, 4));
+  v.set(2, std::complex<U>(0, -12));
+  EXPECT_NEAR(U(13), norm2(v), U(1e-5));
+  EXPECT_EQ(U(12), norm_inf(v));
+
+  split_complex_vector<U> huge(2);
+  huge.set(0, std::complex<U>(std::numeric_limits<U>::max() / 2, std::numeric_limits<U>::max() / 2));
+  EXPECT_TRUE(std::isfinite(norm2(huge)));
+}
+
+TEST(split_complexTest, parts_must_have_equal_sizes) {
+  EXPECT_THROW(split_complex_vector<double>(vector<double>(2), vector<double>(3)), std::invalid_argument);
+}
@@ -0,0 +1,109 @@
+/*
+MIT License
+
+Copyright (c) 2022 Daisuke NAGAO
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#include <gtest/gtest.h>
+
+#include <dicek/statistics_resource.hpp>
+#include <memory_resource>
+#include <thread>
+
+using dicek::allocation_statistics;
+using dicek::statistics_resource;
+
+TEST(statistics_resourceTest, histogram_bin) {
+  EXPECT_EQ(0, allocation_statistics::histogram_bin(0));
+  EXPECT_EQ(0, allocation_statistics::histogram_bin(1));
+  EXPECT_EQ(1, allocation_statistics::histogram_bin(2));
+  EXPECT_EQ(2, allocation_statistics::histogram_bin(3));
+  EXPECT_EQ(2, allocation_statistics::histogram_bin(4));
+  EXPECT_EQ(3, allocation_statistics::histogram_bin(5));
+  EXPECT_EQ(10, allocation_statistics::histogram_bin(1024));
+  EXPECT_EQ(11, allocation_statistics::histogram_bin(1025));
+}
+
+TEST(statistics_resourceTest, counts_bytes_and_peak) {
+  statistics_resource mr;
+  EXPECT_EQ(std::pmr::get_default_resource(), mr.upstream_resource());
+
+  void* a = mr.allocate(100, 8);
+  void* b = mr.allocate(24, 8);
+  mr.deallocate(a, 100, 8);
+  void* c = mr.allocate(16, 8);
+
+  const auto stats = mr.statistics();
+  EXPECT_EQ(3, stats.allocations);
+  EXPECT_EQ(1, stats.deallocations);
+  EXPECT_EQ(140, stats.bytes_allocated);
+  EXPECT_EQ(100, stats.bytes_deallocated);
+  EXPECT_EQ(40, stats.bytes_in_use());
+  EXPECT_EQ(124, stats.peak_bytes);
+  EXPECT_EQ(1, stats.histogram[7]);
+  EXPECT_EQ(1, stats.histogram[5]);
+  EXPECT_EQ(1, stats.histogram[4]);
+
+  mr.deallocate(b, 24, 8);
+  mr.deallocate(c, 16, 8);
+  EXPECT_EQ(0, mr.statistics().bytes_in_use());
+
+  mr.reset();
+  EXPECT_EQ(0, mr.statistics().allocations);
+  EXPECT_EQ(0, mr.statistics().peak_bytes);
+}
+
+TEST(statistics_resourceTest, wraps_upstream) {
+  // a failed upstream allocation is not recorded
+  statistics_resource failing(std::pmr::null_memory_resource());
+  EXPECT_EQ(std::pmr::null_memory_resource(), failing.upstream_resource());
+  EXPECT_THROW(static_cast<void>(failing.allocate(8, 8)), std::bad_alloc);
+  EXPECT_EQ(0, failing.statistics().allocations);
+
+  statistics_resource mr;
+  statistics_resource outer(&mr);
+  void* p = outer.allocate(0, 1);
+  EXPECT_EQ(1, outer.statistics().allocations);
+  EXPECT_EQ(1, mr.statistics().allocations);
+  outer.deallocate(p, 0, 1);
+  EXPECT_TRUE(mr.is_equal(mr));
+  EXPECT_FALSE(mr.is_equal(outer));
+}
+
+TEST(statistics_resourceTest, thread_statistics) {
+  statistics_resource mr;
+  void* p = nullptr;
+  std::thread worker([&] { p = mr.allocate(64, 8); });
+  const auto worker_id = worker.get_id();
+  worker.join();
+  mr.deallocate(p, 64, 8);
+
+  const auto main_stats = mr.thread_statistics();
+  EXPECT_EQ(0, main_stats.allocations);
+  EXPECT_EQ(1, main_stats.deallocations);
+
+  const auto worker_stats = mr.thread_statistics(worker_id);
+  EXPECT_EQ(1, worker_stats.allocations);
+  EXPECT_EQ(0, worker_stats.deallocations);
+  EXPECT_EQ(64, worker_stats.peak_bytes);
+
+  EXPECT_EQ(1, mr.statistics().allocations);
+  EXPECT_EQ(1, mr.statistics().deallocations);
+}
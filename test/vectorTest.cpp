@@ -25,9 +25,15 @@ SOFTWARE.
 
 #include <array>
 #include <complex>
+#include <cstdint>
 #include <dicek/linalg/vector.hpp>
+#include <dicek/statistics_resource.hpp>
+#include <limits>
 #include <memory_resource>
+#include <numeric>
+#include <thread>
 #include <utility>
+#include <vector>
 
 template<typename scalar_traits>
 using vector = dicek::math::linalg::vector<scalar_traits>;
@@ -41,15 +47,25 @@ class allocation_control_resource : public std::pmr::memory_resource {
     reject_allocations_ = true;
   }
 
+  std::size_t allocations() const {
+    return allocations_;
+  }
+
+  std::size_t deallocations() const {
+    return deallocations_;
+  }
+
  private:
   void* do_allocate(std::size_t bytes, std::size_t alignment) override {
     if (reject_allocations_) {
       throw std::bad_alloc();
     }
+    ++allocations_;
     return std::pmr::new_delete_resource()->allocate(bytes, alignment);
   }
 
   void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override {
+    ++deallocations_;
     std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
   }
 
@@ -57,7 +73,9 @@ class allocation_control_resource : public std::pmr::memory_resource {
     return this == &other;
   }
 
-  bool reject_allocations_ = false;
+  bool reject_allocations_   = false;
+  std::size_t allocations_   = 0;
+  std::size_t deallocations_ = 0;
 };
 
 TEST(vectorTest, default_constructor) {
@@ -114,6 +132,42 @@ TEST(vectorTest, size_and_allocator_constructor) {
   }
 }
 
+TEST(vectorTest, size_constructor_allocates_a_single_block) {
+  allocation_control_resource mr;
+  {
+    vector<std::complex<double>> vec(7, &mr);
+    EXPECT_EQ(1, mr.allocations());
+    EXPECT_EQ(1, vec.ref_count());
+    EXPECT_EQ(0, reinterpret_cast<std::uintptr_t>(vec.data()) % alignof(std::complex<double>));
+
+    auto copy_vec = vec;
+    EXPECT_EQ(1, mr.allocations());
+    EXPECT_EQ(2, vec.ref_count());
+  }
+  EXPECT_EQ(1, mr.deallocations());
+}
+
+TEST(vectorTest, default_init_constructor) {
+  allocation_control_resource mr;
+  vector<double> vec(4, dicek::math::linalg::default_init, &mr);
+
+  EXPECT_EQ(4, vec.size());
+  EXPECT_EQ(1, vec.ref_count());
+  EXPECT_EQ(1, mr.allocations());
+  EXPECT_EQ(&mr, vec.get_allocator());
+
+  for (std::size_t i = 0; i < vec.size(); ++i) {
+    vec.at(i) = static_cast<double>(i);
+  }
+  EXPECT_DOUBLE_EQ(3.0, vec.at(3));
+
+  // elements that are not trivially default-constructible are still constructed
+  vector<std::complex<double>> cvec(3, dicek::math::linalg::default_init);
+  for (std::size_t i = 0; i < cvec.size(); ++i) {
+    EXPECT_EQ(std::complex<double>(), cvec.at(i));
+  }
+}
+
 TEST(vectorTest, size_and_null_allocator_constructor) {
   using type                     = float;
   std::pmr::memory_resource* pmr = std::pmr::null_memory_resource();
@@ -204,6 +258,160 @@ TEST(vectorTest, copy_constructor) {
   EXPECT_EQ(2, copy_vec.ref_count());
 }
 
+TEST(vectorTest, synchronized_storage_policy_copies_across_threads) {
+  using shared_vector = dicek::math::linalg::vector<double, scalar_traits<double>, dicek::math::linalg::synchronized_storage_policy>;
+  shared_vector vec({1.0, 2.0, 3.0});
+
+  std::vector<std::thread> workers;
+  for (int t = 0; t < 4; ++t) {
+    workers.emplace_back([vec]() {
+      for (int i = 0; i < 10000; ++i) {
+        shared_vector copy = vec;
+        EXPECT_EQ(vec.data(), copy.data());
+      }
+    });
+  }
+  for (auto& worker : workers) {
+    worker.join();
+  }
+
+  EXPECT_EQ(1, vec.ref_count());
+  EXPECT_DOUBLE_EQ(14.0, dot(vec, vec));
+  EXPECT_DOUBLE_EQ(std::sqrt(14.0), norm(vec, 2.0));
+}
+
+TEST(vectorTest, small_buffer_policy_keeps_short_vectors_inline) {
+  using small_vector = dicek::math::linalg::vector<double, scalar_traits<double>, dicek::math::linalg::small_buffer_policy<4>>;
+  allocation_control_resource mr;
+
+  small_vector v1({1.0, 2.0, 3.0}, &mr);
+  small_vector v2 = v1;
+  EXPECT_EQ(0, mr.allocations());
+  EXPECT_NE(v1.data(), v2.data());
+  EXPECT_EQ(1, v1.ref_count());
+  EXPECT_EQ(1, v2.ref_count());
+  EXPECT_EQ(&mr, v2.get_allocator());
+
+  v2.at(0) = 10.0;
+  EXPECT_DOUBLE_EQ(1.0, v1.at(0));
+
+  auto sum = v1 + v2;
+  EXPECT_EQ(0, mr.allocations());
+  EXPECT_DOUBLE_EQ(11.0, sum.at(0));
+  EXPECT_DOUBLE_EQ(4.0, sum.at(1));
+
+  small_vector moved = std::move(v2);
+  EXPECT_EQ(0, v2.size());
+  EXPECT_DOUBLE_EQ(10.0, moved.at(0));
+  EXPECT_DOUBLE_EQ(3.0, moved.at(2));
+
+  small_vector long_vec({1.0, 2.0, 3.0, 4.0, 5.0}, &mr);
+  auto shared = long_vec;
+  EXPECT_EQ(1, mr.allocations());
+  EXPECT_EQ(long_vec.data(), shared.data());
+  EXPECT_EQ(2, long_vec.ref_count());
+
+  const auto long_data = long_vec.data();
+  swap(moved, long_vec);
+  EXPECT_EQ(long_data, moved.data());
+  EXPECT_EQ(5, moved.size());
+  EXPECT_EQ(3, long_vec.size());
+  EXPECT_DOUBLE_EQ(10.0, long_vec.at(0));
+  EXPECT_DOUBLE_EQ(3.0, long_vec.at(2));
+
+  long_vec = moved;
+  EXPECT_EQ(3, moved.ref_count());
+  EXPECT_DOUBLE_EQ(5.0, long_vec.at(4));
+}
+
+TEST(vectorTest, copy_on_write_policy_detaches_on_first_write) {
+  using cow_vector = dicek::math::linalg::vector<double, scalar_traits<double>, dicek::math::linalg::copy_on_write_policy<>>;
+  allocation_control_resource mr;
+
+  cow_vector v1({1.0, 2.0, 3.0}, &mr);
+  cow_vector v2         = v1;
+  const cow_vector& cv2 = v2;
+  EXPECT_EQ(1, mr.allocations());
+  EXPECT_EQ(2, v1.ref_count());
+
+  // reads keep sharing
+  EXPECT_DOUBLE_EQ(1.0, cv2[0]);
+  EXPECT_EQ(static_cast<const cow_vector&>(v1).data(), cv2.data());
+  EXPECT_EQ(1, mr.allocations());
+
+  // the first write gives the writer its own buffer
+  v2[0] = 10.0;
+  EXPECT_EQ(2, mr.allocations());
+  EXPECT_NE(cv2.data(), static_cast<const cow_vector&>(v1).data());
+  EXPECT_EQ(1, v1.ref_count());
+  EXPECT_EQ(1, v2.ref_count());
+  EXPECT_EQ(&mr, v2.get_allocator());
+  EXPECT_DOUBLE_EQ(1.0, v1[0]);
+  EXPECT_DOUBLE_EQ(10.0, v2[0]);
+  EXPECT_DOUBLE_EQ(2.0, v2[1]);
+
+  // later writes to a sole owner do not copy
+  v2.at(1) = 20.0;
+  v2 *= 2.0;
+  EXPECT_EQ(2, mr.allocations());
+
+  // in-place operations detach too, also when the operand is the shared buffer
+  cow_vector v3 = v1;
+  v3 += v1;
+  EXPECT_EQ(3, mr.allocations());
+  EXPECT_DOUBLE_EQ(1.0, v1[0]);
+  EXPECT_DOUBLE_EQ(2.0, v3[0]);
+
+  cow_vector v4 = v1;
+  v1.scale_into(3.0, v4);
+  EXPECT_DOUBLE_EQ(1.0, v1[0]);
+  EXPECT_DOUBLE_EQ(3.0, v4[0]);
+
+  cow_vector v5 = v1;
+  v5.assign(lazy(v1) * 2.0);
+  EXPECT_DOUBLE_EQ(1.0, v1[0]);
+  EXPECT_DOUBLE_EQ(2.0, v5[0]);
+
+  cow_vector v6 = v1;
+  std::fill(v6.begin(), v6.end(), 0.0);
+  EXPECT_DOUBLE_EQ(3.0, v1[2]);
+  EXPECT_DOUBLE_EQ(0.0, v6[2]);
+}
+
+TEST(vectorTest, aligned_storage_policy_aligns_owned_buffers) {
+  using dicek::math::linalg::aligned_storage_policy;
+  using cache_line_vector = dicek::math::linalg::vector<double, scalar_traits<double>, aligned_storage_policy<64>>;
+  using page_vector       = dicek::math::linalg::vector<float, scalar_traits<float>, aligned_storage_policy<4096, dicek::math::linalg::synchronized_storage_policy>>;
+  using small_vector      = dicek::math::linalg::vector<double, scalar_traits<double>, dicek::math::linalg::small_buffer_policy<4, aligned_storage_policy<32>>>;
+  const auto aligned_to   = [](const void* p, std::size_t alignment) { return reinterpret_cast<std::uintptr_t>(p) % alignment == 0; };
+
+  static_assert(cache_line_vector::alignment == 64);
+  static_assert(page_vector::alignment == 4096);
+  static_assert(vector<std::complex<double>>::alignment == alignof(std::complex<double>));
+
+  for (std::size_t n : {1, 3, 8, 100}) {
+    cache_line_vector v(n);
+    EXPECT_TRUE(aligned_to(v.data(), 64));
+    EXPECT_TRUE(aligned_to(v.clone().data(), 64));
+    EXPECT_TRUE(aligned_to(v.add(v).data(), 64));
+    EXPECT_TRUE(aligned_to((v * 2.0).data(), 64));
+    EXPECT_TRUE(aligned_to(v.map([](double a) { return a; }).data(), 64));
+    EXPECT_TRUE(aligned_to(cache_line_vector(lazy(v) + v).data(), 64));
+  }
+
+  page_vector p{1.0f, 2.0f, 3.0f};
+  EXPECT_TRUE(aligned_to(p.data(), 4096));
+  EXPECT_FLOAT_EQ(3.0f, p[2]);
+  const page_vector q = p.scale(2.0f);
+  EXPECT_TRUE(aligned_to(q.data(), 4096));
+  EXPECT_FLOAT_EQ(6.0f, q[2]);
+
+  small_vector inline_v{1.0, 2.0};
+  small_vector heap_v{1.0, 2.0, 3.0, 4.0, 5.0};
+  EXPECT_TRUE(aligned_to(inline_v.data(), 32));
+  EXPECT_TRUE(aligned_to(heap_v.data(), 32));
+}
+
 TEST(vectorTest, move_constructor) {
   using type = float;
   vector<type> vec(5);
@@ -287,6 +495,39 @@ TEST(vectorTest, begin_end) {
   EXPECT_EQ(ceite, cvec.cend());
 }
 
+TEST(vectorTest, with_ranges_passes_pointers_for_contiguous_vectors) {
+  using dicek::math::linalg::with_ranges;
+  std::array<double, 8> buf = {1, 2, 3, 4, 5, 6, 7, 8};
+  const vector<double> contiguous(buf.data(), 4);
+  const vector<double> strided(buf.data(), 4, 2);
+  vector<double> out(4);
+
+  bool pointers = false;
+  with_ranges(
+      [&](auto first, auto last, auto dst) {
+        pointers = std::is_pointer_v<decltype(first)> && std::is_pointer_v<decltype(dst)>;
+        std::copy(first, last, dst);
+      },
+      contiguous, out);
+  EXPECT_TRUE(pointers);
+  EXPECT_EQ(4.0, out[3]);
+
+  // the choice is made per vector
+  with_ranges([&](auto first, auto, auto dst) { pointers = std::is_pointer_v<decltype(first)> || !std::is_pointer_v<decltype(dst)>; }, strided, out);
+  EXPECT_FALSE(pointers);
+  EXPECT_EQ(50.0, with_ranges([](auto first, auto last, auto rhs) { return std::inner_product(first, last, rhs, 0.0); }, contiguous, strided));
+  const vector<double> shorter(3);
+  EXPECT_THROW(with_ranges([](auto, auto, auto) {}, contiguous, shorter), std::invalid_argument);
+
+  // mutable ranges detach a shared copy-on-write vector before it is written through them
+  using cow_vector = dicek::math::linalg::vector<double, scalar_traits<double>, dicek::math::linalg::copy_on_write_policy<>>;
+  const cow_vector original({1.0, 2.0, 3.0});
+  cow_vector copy = original;
+  with_ranges([](auto first, auto last) { std::fill(first, last, 0.0); }, copy);
+  EXPECT_EQ(1.0, original[0]);
+  EXPECT_EQ(0.0, std::as_const(copy)[0]);
+}
+
 TEST(vectorTest, swap) {
   using std::swap;
   using type = float;
@@ -516,6 +757,177 @@ TEST(vectorTest, in_place_operations_do_not_allocate_for_identical_views) {
   EXPECT_DOUBLE_EQ(0.0, v.at(2));
 }
 
+TEST(vectorTest, allocations_per_operation) {
+  dicek::statistics_resource mr;
+  const auto allocations_of = [&mr](auto&& f) {
+    const auto before = mr.statistics().allocations;
+    f();
+    return mr.statistics().allocations - before;
+  };
+
+  vector<double> x(1000, &mr);
+  vector<double> y(1000, &mr);
+  vector<double> z(1000, &mr);
+  std::array<double, 2000> buf{};
+  vector<double> strided(buf.data(), 1000, 2);
+
+  EXPECT_EQ(1, allocations_of([&] { vector<double> v(1000, &mr); }));
+  EXPECT_EQ(1, allocations_of([&] { vector<double> v(1000, dicek::math::linalg::default_init, &mr); }));
+  EXPECT_EQ(0, allocations_of([&] { vector<double> v(buf.data(), 1000, 2); }));
+  EXPECT_EQ(0, allocations_of([&] { const auto copy = x; }));
+  EXPECT_EQ(0, allocations_of([&] { auto copy = x; const auto moved = std::move(copy); }));
+  EXPECT_EQ(1, allocations_of([&] { const auto r = x.clone(); }));
+  EXPECT_EQ(1, allocations_of([&] { const auto r = x.add(y); }));
+  EXPECT_EQ(1, allocations_of([&] { const auto r = x.subtract(y); }));
+  EXPECT_EQ(1, allocations_of([&] { const auto r = x.scale(2.0); }));
+  EXPECT_EQ(1, allocations_of([&] { const auto r = x.map([](double a) { return a * a; }); }));
+  EXPECT_EQ(1, allocations_of([&] { const auto r = -x; }));
+  // later operators reuse the uniquely owned temporary
+  EXPECT_EQ(1, allocations_of([&] { const auto r = (x + y) * 2.0 - z; }));
+  EXPECT_EQ(1, allocations_of([&] { const auto r = -(2.0 * (x - y) / 4.0 + z); }));
+  EXPECT_EQ(1, allocations_of([&] { const vector<double> r = (lazy(x) + y) * 2.0 - z; }));
+
+  EXPECT_EQ(1, allocations_of([&] { z = (lazy(x) + y) * 2.0; }));
+
+  // the hot-loop operations on existing vectors allocate nothing
+  EXPECT_EQ(0, allocations_of([&] { z.assign((lazy(x) + y) * 2.0); }));
+  EXPECT_EQ(0, allocations_of([&] { x += y; }));
+  EXPECT_EQ(0, allocations_of([&] { x -= y; }));
+  EXPECT_EQ(0, allocations_of([&] { x *= 2.0; }));
+  EXPECT_EQ(0, allocations_of([&] { x += x; }));
+  EXPECT_EQ(0, allocations_of([&] { z = x; }));
+  EXPECT_EQ(0, allocations_of([&] { EXPECT_EQ(0.0, dot(x, y)); }));
+  EXPECT_EQ(0, allocations_of([&] { EXPECT_EQ(0.0, norm1(x) + norm2(x) + norm_inf(x)); }));
+  EXPECT_EQ(0, allocations_of([&] { EXPECT_EQ(0.0, norm2(strided)); }));
+
+  // z * 2.0 is evaluated eagerly, so the expression does not alias z
+  EXPECT_EQ(1, allocations_of([&] { z.assign(lazy(x) + z * 2.0 + x); }));
+}
+
+TEST(vectorTest, into_variants_write_into_destination) {
+  dicek::statistics_resource mr;
+  const vector<double> x({1.0, 2.0, 3.0, 4.0, 5.0}, &mr);
+  const vector<double> y({5.0, 4.0, 3.0, 2.0, 1.0}, &mr);
+  vector<double> dst(5, &mr);
+  const auto allocations = mr.statistics().allocations;
+
+  EXPECT_EQ(&dst, &x.add_into(y, dst));
+  for (std::size_t i = 0; i < dst.size(); ++i) {
+    EXPECT_DOUBLE_EQ(6.0, dst[i]);
+  }
+  x.subtract_into(y, dst);
+  for (std::size_t i = 0; i < dst.size(); ++i) {
+    EXPECT_DOUBLE_EQ(x[i] - y[i], dst[i]);
+  }
+  x.scale_into(2.0, dst);
+  for (std::size_t i = 0; i < dst.size(); ++i) {
+    EXPECT_DOUBLE_EQ(2.0 * x[i], dst[i]);
+  }
+  x.map_into([](double a) { return a * a; }, dst);
+  for (std::size_t i = 0; i < dst.size(); ++i) {
+    EXPECT_DOUBLE_EQ(x[i] * x[i], dst[i]);
+  }
+  EXPECT_EQ(allocations, mr.statistics().allocations);
+
+  // strided destination leaves the elements in between alone
+  std::array<double, 10> buf{};
+  buf.fill(-1.0);
+  vector<double> strided(buf.data(), 5, 2);
+  x.add_into(y, strided);
+  x.scale_into(3.0, strided);
+  for (std::size_t i = 0; i < 5; ++i) {
+    EXPECT_DOUBLE_EQ(3.0 * x[i], buf[2 * i]);
+    EXPECT_DOUBLE_EQ(-1.0, buf[2 * i + 1]);
+  }
+  strided.add_into(y, dst);
+  EXPECT_DOUBLE_EQ(8.0, dst[0]);
+  EXPECT_DOUBLE_EQ(16.0, dst[4]);
+
+  vector<double> short_dst(4);
+  EXPECT_THROW(x.add_into(y, short_dst), std::invalid_argument);
+  EXPECT_THROW(x.subtract_into(y, short_dst), std::invalid_argument);
+  EXPECT_THROW(x.scale_into(1.0, short_dst), std::invalid_argument);
+  EXPECT_THROW(x.map_into([](double a) { return a; }, short_dst), std::invalid_argument);
+  EXPECT_THROW(x.add_into(short_dst, dst), std::invalid_argument);
+}
+
+TEST(vectorTest, into_variants_handle_aliasing) {
+  // the destination is one of the operands
+  vector<double> v{1.0, 2.0, 3.0};
+  const vector<double> w{1.0, 1.0, 1.0};
+  v.add_into(w, v);
+  w.subtract_into(v, v);
+  EXPECT_DOUBLE_EQ(-1.0, v[0]);
+  EXPECT_DOUBLE_EQ(-2.0, v[1]);
+  EXPECT_DOUBLE_EQ(-3.0, v[2]);
+
+  // the destination is shifted by one element against both operands
+  std::array<double, 4> buf{1.0, 2.0, 3.0, 4.0};
+  const vector<double> lo(buf.data(), 3);
+  vector<double> hi(buf.data() + 1, 3);
+  lo.add_into(lo, hi);
+  EXPECT_DOUBLE_EQ(1.0, buf[0]);
+  EXPECT_DOUBLE_EQ(2.0, buf[1]);
+  EXPECT_DOUBLE_EQ(4.0, buf[2]);
+  EXPECT_DOUBLE_EQ(6.0, buf[3]);
+
+  // the destination reverses its operand
+  std::array<double, 3> rev_buf{1.0, 2.0, 3.0};
+  const vector<double> forward(rev_buf.data(), 3);
+  vector<double> backward(rev_buf.data() + 2, 3, -1);
+  forward.scale_into(10.0, backward);
+  EXPECT_DOUBLE_EQ(30.0, rev_buf[0]);
+  EXPECT_DOUBLE_EQ(20.0, rev_buf[1]);
+  EXPECT_DOUBLE_EQ(10.0, rev_buf[2]);
+  forward.map_into([](double a) { return a + 1.0; }, backward);
+  EXPECT_DOUBLE_EQ(11.0, rev_buf[0]);
+  EXPECT_DOUBLE_EQ(21.0, rev_buf[1]);
+  EXPECT_DOUBLE_EQ(31.0, rev_buf[2]);
+}
+
+TEST(vectorTest, rvalue_operators_reuse_unique_storage) {
+  const vector<double> a{1.0, 2.0, 3.0};
+  const vector<double> b{4.0, 5.0, 6.0};
+
+  vector<double> tmp    = a + b;
+  const double* storage = tmp.data();
+  vector<double> r      = ((std::move(tmp) * 2.0 - a) / 2.0 + b) * -1.0;
+  EXPECT_EQ(storage, r.data());
+  EXPECT_DOUBLE_EQ(-8.5, r[0]);
+  EXPECT_DOUBLE_EQ(-11.0, r[1]);
+  EXPECT_DOUBLE_EQ(-13.5, r[2]);
+
+  r = -std::move(r);
+  EXPECT_EQ(storage, r.data());
+  r = 2.0 * std::move(r);
+  EXPECT_EQ(storage, r.data());
+  EXPECT_DOUBLE_EQ(17.0, r[0]);
+
+  // r - r: the right operand is the same storage
+  r = std::move(r) - r;
+  EXPECT_EQ(storage, r.data());
+  EXPECT_DOUBLE_EQ(0.0, r[0]);
+
+  // shared storage is left alone
+  vector<double> shared     = a.clone();
+  const vector<double> keep = shared;
+  const vector<double> sum  = std::move(shared) + b;
+  EXPECT_NE(keep.data(), sum.data());
+  EXPECT_DOUBLE_EQ(1.0, keep[0]);
+  EXPECT_DOUBLE_EQ(5.0, sum[0]);
+
+  // so is external memory
+  std::array<double, 3> buf{1.0, 2.0, 3.0};
+  vector<double> view(buf.data(), 3);
+  const vector<double> scaled = std::move(view) * 2.0;
+  EXPECT_NE(buf.data(), scaled.data());
+  EXPECT_DOUBLE_EQ(1.0, buf[0]);
+
+  vector<double> short_tmp{1.0, 2.0};
+  EXPECT_THROW(std::move(short_tmp) + a, std::invalid_argument);
+  EXPECT_THROW(std::move(short_tmp) - a, std::invalid_argument);
+}
+
 TEST(vectorTest, numerical_operations_reject_size_mismatch) {
   vector<double> v1({1.0, 2.0, 3.0});
   vector<double> v2({10.0, 20.0});
@@ -550,3 +962,321 @@ TEST(vectorTest, complex_dot_uses_conjugated_rhs) {
   EXPECT_EQ(expected, inner_product(v1, v2));
   EXPECT_DOUBLE_EQ(std::sqrt(91.0), norm(v1, 2.0));
 }
+
+TEST(vectorTest, float_reductions_accumulate_in_double) {
+  /* 2^27 + 1 is not a float: summed in float, every one added to the large lane would be lost */
+  constexpr std::size_t N = 1024;
+  vector<float> x(N), ones(N);
+  for (std::size_t i = 0; i < N; ++i) {
+    x[i]    = 1.0f;
+    ones[i] = 1.0f;
+  }
+  x[0] = 0x1p27f;
+
+  const double expected = 0x1p27 + (N - 1);
+  EXPECT_EQ(static_cast<float>(expected), dot(x, ones));
+  EXPECT_EQ(static_cast<float>(expected), norm1(x));
+  static_assert(std::is_same_v<float, decltype(dot(x, ones))>, "dot returns scalar_type");
+
+  vector<float> strided(x.data(), N / 2, 2);
+  EXPECT_EQ(static_cast<float>(0x1p27 + (N / 2 - 1)), norm1(strided));
+}
+
+namespace {
+/* strong typedef of double that opts in to the double kernels */
+struct meters {
+  explicit meters(double v = 0.0) : value(v) {}
+  explicit operator double() const {
+    return value;
+  }
+  meters& operator+=(meters rhs) {
+    value += rhs.value;
+    return *this;
+  }
+  meters& operator-=(meters rhs) {
+    value -= rhs.value;
+    return *this;
+  }
+  meters& operator*=(meters rhs) {
+    value *= rhs.value;
+    return *this;
+  }
+  friend meters operator+(meters lhs, meters rhs) {
+    return meters(lhs.value + rhs.value);
+  }
+  friend meters operator-(meters lhs, meters rhs) {
+    return meters(lhs.value - rhs.value);
+  }
+  friend meters operator*(meters lhs, meters rhs) {
+    return meters(lhs.value * rhs.value);
+  }
+  double value;
+};
+
+struct meters_traits {
+  using scalar_type      = meters;
+  using accumulator_type = double;
+  using kernel_type      = double;
+
+  static meters conj(meters val) {
+    return val;
+  }
+  static double abs(meters val) {
+    return std::abs(val.value);
+  }
+};
+
+/* counts copy constructions; memcpy-safe, and its traits say so */
+struct counted {
+  counted(double v = 0.0) : value(v) {}
+  counted(const counted& rhs) : value(rhs.value) {
+    ++copies;
+  }
+  counted& operator=(const counted&) = default;
+  static inline int copies = 0;
+  double value;
+};
+
+struct counted_traits {
+  using scalar_type = counted;
+
+  static constexpr bool is_trivially_copyable = true;
+  static counted conj(counted val) {
+    return val;
+  }
+  static double abs(counted val) {
+    return std::abs(val.value);
+  }
+};
+}  // namespace
+
+TEST(vectorTest, user_type_opts_in_to_double_kernels) {
+  using meters_vector = dicek::math::linalg::vector<meters, meters_traits>;
+  static_assert(meters_vector::simd_width == vector<double>::simd_width, "meters runs the double kernels");
+  static_assert(vector<std::complex<double>>::simd_width == 1, "interleaved complex runs plain loops");
+
+  constexpr std::size_t N = 1027;
+  meters_vector x(N), y(N);
+  vector<double> dx(N), dy(N);
+  for (std::size_t i = 0; i < N; ++i) {
+    dx[i] = static_cast<double>(i % 7) - 3.0;
+    dy[i] = 0.25 * static_cast<double>(i % 5);
+    x[i]  = meters(dx[i]);
+    y[i]  = meters(dy[i]);
+  }
+
+  const auto sum    = x + y;
+  const auto scaled = x * meters(1.5);
+  x += y;
+  for (std::size_t i = 0; i < N; ++i) {
+    EXPECT_EQ(dx[i] + dy[i], sum[i].value);
+    EXPECT_EQ(dx[i] * 1.5, scaled[i].value);
+    EXPECT_EQ(dx[i] + dy[i], x[i].value);
+  }
+  dx += dy;
+  EXPECT_EQ(dot(dx, dy), dot(x, y).value);
+  EXPECT_EQ(norm2(dx), norm2(x));
+  EXPECT_EQ(norm1(dx), norm1(x));
+
+  meters_vector strided(x.data(), N / 2, 2);
+  vector<double> dstrided(dx.data(), N / 2, 2);
+  EXPECT_DOUBLE_EQ(norm2(dstrided), norm2(strided));
+}
+
+TEST(vectorTest, trivially_copyable_traits_copy_with_memcpy) {
+  using counted_vector = dicek::math::linalg::vector<counted, counted_traits, dicek::math::linalg::small_buffer_policy<8>>;
+  counted_vector v(4);
+  for (std::size_t i = 0; i < v.size(); ++i) {
+    v[i] = counted(static_cast<double>(i));
+  }
+
+  counted::copies        = 0;
+  const auto inline_copy = v;
+  const auto cloned      = v.clone();
+  counted_vector large(100);
+  const auto large_clone = large.clone();
+  EXPECT_EQ(0, counted::copies);
+  for (std::size_t i = 0; i < v.size(); ++i) {
+    EXPECT_EQ(static_cast<double>(i), inline_copy[i].value);
+    EXPECT_EQ(static_cast<double>(i), cloned[i].value);
+  }
+
+  /* the reductions without kernels sum in unrolled partial sums */
+  EXPECT_EQ(6.0, norm1(v));
+}
+
+template<typename T>
+class vectorKernelTest : public ::testing::Test {};
+
+using kernel_types = ::testing::Types<float, double>;
+TYPED_TEST_SUITE(vectorKernelTest, kernel_types);
+
+TYPED_TEST(vectorKernelTest, contiguous_kernels_match_element_wise_results) {
+  using type = TypeParam;
+  // not a multiple of any vector width so the scalar tail is exercised as well
+  constexpr std::size_t N = 1027;
+
+  vector<type> x(N), y(N);
+  for (std::size_t i = 0; i < N; ++i) {
+    x[i] = static_cast<type>(i % 7) - 3;
+    y[i] = static_cast<type>(i % 5) + 1;
+  }
+
+  const auto sum        = x + y;
+  const auto difference = x - y;
+  const auto scaled     = x * type(2);
+  type expected_dot     = 0;
+  type expected_squares = 0;
+  for (std::size_t i = 0; i < N; ++i) {
+    EXPECT_EQ(x[i] + y[i], sum[i]);
+    EXPECT_EQ(x[i] - y[i], difference[i]);
+    EXPECT_EQ(x[i] * type(2), scaled[i]);
+    expected_dot += x[i] * y[i];
+    expected_squares += x[i] * x[i];
+  }
+
+  // all partial sums are small integers, so every summation order is exact
+  EXPECT_EQ(expected_dot, dot(x, y));
+  EXPECT_EQ(std::sqrt(expected_squares), norm(x, type(2)));
+
+  auto z = x.clone();
+  z += y;
+  z -= x;
+  z *= type(3);
+  for (std::size_t i = 0; i < N; ++i) {
+    EXPECT_EQ(y[i] * type(3), z[i]);
+  }
+}
+
+TYPED_TEST(vectorKernelTest, mixed_contiguous_and_strided_operands) {
+  using type               = TypeParam;
+  std::array<type, 10> buf = {1, -1, 2, -1, 3, -1, 4, -1, 5, -1};
+
+  vector<type> strided(buf.data(), 5, 2);
+  vector<type> contiguous({10, 20, 30, 40, 50});
+
+  const auto sum = contiguous + strided;
+  EXPECT_EQ(type(11), sum.at(0));
+  EXPECT_EQ(type(55), sum.at(4));
+  EXPECT_EQ(type(550), dot(strided, contiguous));
+  EXPECT_EQ(type(550), dot(contiguous, strided));
+  EXPECT_FALSE(strided.is_contiguous());
+  EXPECT_TRUE(contiguous.is_contiguous());
+  EXPECT_EQ(2, strided.step());
+}
+
+TYPED_TEST(vectorKernelTest, strided_kernels_match_element_wise_results) {
+  using type = TypeParam;
+  // columns of a row-major matrix: a step long enough to be prefetched, and more rows than one staging block
+  constexpr std::size_t rows = 601;
+  constexpr std::size_t cols = 521;
+
+  std::vector<type> matrix(rows * cols);
+  for (std::size_t i = 0; i < matrix.size(); ++i) {
+    matrix[i] = static_cast<type>(i % 11) - 5;
+  }
+  const vector<type> x(matrix.data() + 3, rows, static_cast<int>(cols));
+  const vector<type> y(matrix.data() + matrix.size() - 1, rows, -static_cast<int>(cols));
+
+  const auto copy       = x.clone(std::pmr::get_default_resource());
+  const auto squared    = x.map([](type a) { return a * a; });
+  const auto sum        = x + y;
+  const auto difference = x - y;
+  const auto scaled     = y * type(2);
+  EXPECT_TRUE(copy.is_contiguous());
+  type expected_dot     = 0;
+  type expected_abs     = 0;
+  type expected_squares = 0;
+  for (std::size_t i = 0; i < rows; ++i) {
+    EXPECT_EQ(matrix[i * cols + 3], copy[i]);
+    EXPECT_EQ(x[i] * x[i], squared[i]);
+    EXPECT_EQ(x[i] + y[i], sum[i]);
+    EXPECT_EQ(x[i] - y[i], difference[i]);
+    EXPECT_EQ(y[i] * type(2), scaled[i]);
+    expected_dot += x[i] * y[i];
+    expected_abs += std::abs(x[i]);
+    expected_squares += x[i] * x[i];
+  }
+  EXPECT_EQ(expected_dot, dot(x, y));
+  EXPECT_EQ(expected_abs, norm1(x));
+  EXPECT_EQ(std::sqrt(expected_squares), norm2(x));
+
+  // strided destinations: one column receives the sum of two others, then is scaled in place
+  vector<type> dst(matrix.data() + 5, rows, static_cast<int>(cols));
+  x.add_into(y, dst);
+  for (std::size_t i = 0; i < rows; ++i) {
+    EXPECT_EQ(sum[i], matrix[i * cols + 5]);
+  }
+  dst *= type(3);
+  for (std::size_t i = 0; i < rows; ++i) {
+    EXPECT_EQ(sum[i] * type(3), matrix[i * cols + 5]);
+  }
+  y.scale_into(type(-1), dst);
+  for (std::size_t i = 0; i < rows; ++i) {
+    EXPECT_EQ(-y[i], matrix[i * cols + 5]);
+  }
+}
+
+TEST(vectorTest, norm1_norm2_and_norm_inf) {
+  vector<double> v({3.0, -4.0, 12.0});
+
+  EXPECT_DOUBLE_EQ(19.0, norm1(v));
+  EXPECT_DOUBLE_EQ(13.0, norm2(v));
+  EXPECT_DOUBLE_EQ(12.0, norm_inf(v));
+
+  EXPECT_DOUBLE_EQ(19.0, norm(v, 1.0));
+  EXPECT_DOUBLE_EQ(13.0, norm(v, 2));
+  EXPECT_DOUBLE_EQ(12.0, norm(v, std::numeric_limits<double>::infinity()));
+
+  std::array<double, 6> buf = {3.0, 0.0, -4.0, 0.0, 12.0, 0.0};
+  vector<double> strided(buf.data(), 3, 2);
+  EXPECT_DOUBLE_EQ(19.0, norm1(strided));
+  EXPECT_DOUBLE_EQ(13.0, norm2(strided));
+  EXPECT_DOUBLE_EQ(12.0, norm_inf(strided));
+
+  using namespace std::literals::complex_literals;
+  vector<std::complex<double>> c({3.0 + 4.0i, -12.0i});
+  EXPECT_DOUBLE_EQ(17.0, norm1(c));
+  EXPECT_DOUBLE_EQ(13.0, norm2(c));
+  EXPECT_DOUBLE_EQ(12.0, norm_inf(c));
+
+  // norm2 of integers is an integer, but norm(v, 2) keeps the root exact
+  const vector<int> i({1, 1});
+  EXPECT_DOUBLE_EQ(std::sqrt(2.0), norm(i, 2));
+  EXPECT_DOUBLE_EQ(std::sqrt(2.0), norm(i, 2.0));
+}
+
+TEST(vectorTest, integer_norm_2_matches_the_general_p_norm) {
+  const vector<int> v({1, -2, 3, 5, -7});
+
+  double sum = 0.0;
+  for (std::size_t k = 0; k < v.size(); ++k) {
+    sum += std::pow(std::abs(static_cast<double>(v[k])), 2.0);
+  }
+  EXPECT_DOUBLE_EQ(std::pow(sum, 1.0 / 2.0), norm(v, 2));
+  EXPECT_DOUBLE_EQ(std::pow(sum, 1.0 / 2.0), norm(v, 2.0));
+  EXPECT_NE(static_cast<double>(norm2(v)), norm(v, 2));
+}
+
+TEST(vectorTest, norm2_does_not_overflow_or_underflow) {
+  vector<double> big({3e200, 4e200});
+  EXPECT_DOUBLE_EQ(5e200, norm2(big));
+  EXPECT_DOUBLE_EQ(5e200, norm(big, 2.0));
+
+  vector<double> tiny({3e-200, -4e-200});
+  EXPECT_DOUBLE_EQ(5e-200, norm2(tiny));
+
+  vector<float> big_float({3e30f, 4e30f});
+  EXPECT_FLOAT_EQ(5e30f, norm2(big_float));
+
+  using namespace std::literals::complex_literals;
+  vector<std::complex<double>> big_complex({3e200 + 4e200i});
+  EXPECT_DOUBLE_EQ(5e200, norm2(big_complex));
+
+  EXPECT_DOUBLE_EQ(0.0, norm2(vector<double>({0.0, 0.0})));
+  EXPECT_DOUBLE_EQ(0.0, norm2(vector<std::complex<double>>({0.0, -0.0i})));
+  EXPECT_DOUBLE_EQ(5e-200, norm2(vector<double>({0.0, 3e-200, 0.0, -4e-200})));
+  EXPECT_TRUE(std::isinf(norm2(vector<double>({1.0, std::numeric_limits<double>::infinity()}))));
+  EXPECT_TRUE(std::isnan(norm2(vector<double>({1.0, std::numeric_limits<double>::quiet_NaN()}))));
+  EXPECT_TRUE(std::isnan(norm_inf(vector<double>({1.0, std::numeric_limits<double>::quiet_NaN(), 2.0}))));
+}